@@ -1,10 +1,11 @@
 #pragma once
 
 #include "main.h"
+#include "autonomous/script.hpp"
 
 namespace auton_routines {
-    void close_side_auto();
-    void far_side_auto();
-    void skills_auto();
+    Script close_side_auto();
+    Script far_side_auto();
+    Script skills_auto();
     void runSelectedAutonomous();
 }
\ No newline at end of file
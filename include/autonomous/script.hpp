@@ -0,0 +1,178 @@
+#pragma once
+
+#include <array>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include "motion/chassis.hpp"
+
+namespace auton_routines {
+
+// Something a script can co_await that is polled once per executor tick until it is ready
+class Condition {
+    public:
+        virtual bool ready() = 0;
+
+        bool await_ready() { return ready(); }
+        // park the awaiting coroutine in the executor until ready() returns true. outside an executor
+        // there is nothing to resume it, so this polls in place instead
+        bool await_suspend(std::coroutine_handle<> handle);
+        void await_resume() {}
+    protected:
+        ~Condition() = default;
+};
+
+// Autonomous coroutine. A function returning Script can co_await conditions and other scripts, and
+// runs on an Executor alongside other scripts without a task of its own
+class Script {
+    public:
+        struct promise_type {
+                std::coroutine_handle<> continuation; // the script awaiting this one, if any
+
+                Script get_return_object() { return Script(Handle::from_promise(*this)); }
+                // scripts start when the executor or an awaiting script first resumes them
+                std::suspend_always initial_suspend() noexcept { return {}; }
+                auto final_suspend() noexcept {
+                    struct Resume {
+                            bool await_ready() noexcept { return false; }
+                            // continue the awaiting script directly, or return to the executor
+                            std::coroutine_handle<> await_suspend(Handle handle) noexcept {
+                                auto continuation = handle.promise().continuation;
+                                return continuation ? continuation : std::noop_coroutine();
+                            }
+                            void await_resume() noexcept {}
+                    };
+                    return Resume {};
+                }
+                void return_void() {}
+                void unhandled_exception() { std::terminate(); }
+        };
+
+        using Handle = std::coroutine_handle<promise_type>;
+
+        Script(Script&& other) noexcept
+            : handle(std::exchange(other.handle, nullptr)) {}
+        Script& operator=(Script&& other) noexcept {
+            if (this != &other) {
+                if (handle) handle.destroy();
+                handle = std::exchange(other.handle, nullptr);
+            }
+            return *this;
+        }
+        Script(const Script&) = delete;
+        ~Script() {
+            if (handle) handle.destroy();
+        }
+
+        bool done() const { return !handle || handle.done(); }
+
+        // co_await a script to run it to completion before continuing. it starts right away
+        auto operator co_await() && noexcept {
+            struct Awaiter {
+                    Handle child;
+
+                    bool await_ready() noexcept { return !child || child.done(); }
+                    std::coroutine_handle<> await_suspend(std::coroutine_handle<> parent) noexcept {
+                        child.promise().continuation = parent;
+                        return child;
+                    }
+                    void await_resume() noexcept {}
+            };
+            return Awaiter {handle};
+        }
+    private:
+        friend class Executor;
+
+        explicit Script(Handle handle)
+            : handle(handle) {}
+
+        Handle handle;
+};
+
+// Runs scripts cooperatively from a single task. Each tick resumes every script whose condition is
+// ready; a script runs until its next co_await of something that is not. All of an executor's scripts
+// must be resumed from the task that ticks it
+class Executor {
+    public:
+        static constexpr std::size_t MAX_SCRIPTS = 8;
+
+        // start a script on the next tick. returns false if MAX_SCRIPTS are already running
+        bool spawn(Script script);
+        // resume the scripts that are ready. returns whether any are still running
+        bool tick();
+        // tick every periodMs until every script has finished
+        void run(std::uint32_t periodMs = 10);
+        // destroy every script, finished or not
+        void clear();
+
+        std::size_t getRunning() const;
+    private:
+        friend class Condition;
+
+        struct Slot {
+                Script script {nullptr};
+                std::coroutine_handle<> resume; // the innermost suspended coroutine
+                Condition* waiting = nullptr; // what it waits on, nullptr to resume on the next tick
+        };
+
+        // the slot being resumed, where awaited conditions register
+        static Slot* active;
+
+        std::array<Slot, MAX_SCRIPTS> slots;
+};
+
+// resume after a number of milliseconds
+class Delay : public Condition {
+    public:
+        explicit Delay(std::uint32_t ms);
+        bool ready() override;
+    private:
+        std::uint32_t deadline;
+};
+
+// resume once a function returns true, e.g. a sensor reading
+template <typename Fn> class Until : public Condition {
+    public:
+        explicit Until(Fn fn)
+            : fn(std::move(fn)) {}
+
+        bool ready() override { return fn(); }
+    private:
+        Fn fn;
+};
+
+// resume once the current chassis motion has traveled a distance (inches, or degrees for turns)
+// or has finished, like lemlib::Chassis::waitUntil
+class Traveled : public Condition {
+    public:
+        Traveled(motion::Chassis& chassis, float distance)
+            : chassis(chassis),
+              distance(distance) {}
+
+        bool ready() override;
+    private:
+        motion::Chassis& chassis;
+        float distance;
+};
+
+// resume once the chassis has no motion running or queued, like lemlib::Chassis::waitUntilDone
+class MotionDone : public Condition {
+    public:
+        explicit MotionDone(lemlib::Chassis& chassis)
+            : chassis(chassis) {}
+
+        bool ready() override { return !chassis.isInMotion(); }
+    private:
+        lemlib::Chassis& chassis;
+};
+
+inline Delay delay(std::uint32_t ms) { return Delay(ms); }
+
+template <typename Fn> Until<Fn> until(Fn fn) { return Until<Fn>(std::move(fn)); }
+
+inline Traveled traveled(motion::Chassis& chassis, float distance) { return Traveled(chassis, distance); }
+
+inline MotionDone motionDone(lemlib::Chassis& chassis) { return MotionDone(chassis); }
+
+} // namespace auton_routines
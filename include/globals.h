@@ -2,16 +2,33 @@
 
 #include "api.h"
 #include "lemlib/api.hpp"
+#include "motion/chassis.hpp"
+#include "runtime/batteryCompensation.hpp"
+#include "runtime/controllerOutput.hpp"
+#include "runtime/motorSampler.hpp"
+#include "runtime/profiler.hpp"
 
 // Controller
 extern pros::Controller controller;
+// Queued controller screen and rumble, use instead of controller.print/rumble
+extern runtime::ControllerOutput controller_output;
 
-// Motor groups
-extern pros::MotorGroup left_mg;
-extern pros::MotorGroup right_mg;
+// Battery compensation shared by every motor below
+extern runtime::BatteryCompensation battery_compensation;
+
+// Motor groups, compensated for the battery voltage
+extern runtime::CompensatedMotorGroup left_mg;
+extern runtime::CompensatedMotorGroup right_mg;
 
 // Motors
-extern pros::Motor intake_mtr;
+extern runtime::CompensatedMotor intake_mtr;
+
+// Motor telemetry, snapshot groups in MotorTelemetryGroup order
+enum MotorTelemetryGroup { LEFT_DRIVE_GROUP, RIGHT_DRIVE_GROUP, INTAKE_GROUP };
+extern runtime::MotorSampler motor_telemetry;
+
+// Loop profiler, one section per driver stage plus finer sections inside them
+extern runtime::Profiler loop_profiler;
 
 // Sensors
 extern pros::Imu inertial;
@@ -21,7 +38,7 @@ extern pros::adi::DigitalOut mogo1;
 extern pros::adi::DigitalOut mogo2;
 
 // Chassis
-extern lemlib::Chassis chassis;
+extern motion::Chassis chassis;
 
 // Autonomous mode
 enum class AutoMode { OFF, CLOSE_SIDE, FAR_SIDE, SKILLS };
@@ -0,0 +1,302 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <vector>
+#include "lemlib/chassis/chassis.hpp"
+#include "pros/gps.hpp"
+#include "pros/rtos.hpp"
+#include "motion/feedforward.hpp"
+#include "motion/gainSchedule.hpp"
+#include "motion/pid.hpp"
+#include "motion/poseFilter.hpp"
+#include "motion/profile.hpp"
+#include "motion/relayTuner.hpp"
+#include "motion/spline.hpp"
+#include "motion/sysid.hpp"
+#include "motion/trajectory.hpp"
+
+namespace motion {
+
+// distance between the points a spline path is sampled into for following, inches
+constexpr float SPLINE_SPACING = 1;
+
+// lemlib PID outputs are on the 127 motor scale
+constexpr float pidToVolts(float output) { return output * MAX_VOLTAGE / 127; }
+
+enum class ProfileShape {
+    NONE, // plain PID, runs the lemlib motion unchanged
+    TRAPEZOIDAL, // acceleration limited
+    S_CURVE // acceleration and jerk limited
+};
+
+// lemlib::MoveToPointParams plus an optional motion profile
+struct MoveToPointParams {
+        bool forwards = true;
+        float maxSpeed = 127;
+        float minSpeed = 0;
+        float earlyExitRange = 0;
+        ProfileShape profile = ProfileShape::NONE;
+        float maxVelocity = 0; // inches/s, 0 for the fastest the feedforward model allows
+        float maxAcceleration = 0; // inches/s^2, 0 for the fastest the feedforward model allows
+        float maxJerk = 0; // inches/s^3, S_CURVE only, 0 to ramp to full acceleration in 0.2 s
+};
+
+// lemlib::TurnToHeadingParams plus an optional motion profile
+struct TurnToHeadingParams {
+        lemlib::AngularDirection direction = lemlib::AngularDirection::AUTO;
+        int maxSpeed = 127;
+        int minSpeed = 0;
+        float earlyExitRange = 0;
+        ProfileShape profile = ProfileShape::NONE;
+        float maxVelocity = 0; // degrees/s, 0 for the fastest the feedforward model allows
+        float maxAcceleration = 0; // degrees/s^2, 0 for the fastest the feedforward model allows
+        float maxJerk = 0; // degrees/s^3, S_CURVE only, 0 to ramp to full acceleration in 0.2 s
+};
+
+// Pure pursuit lookahead that grows with the commanded speed and shrinks for tight turns ahead,
+// within [min, max]. equal bounds give a fixed lookahead
+struct AdaptiveLookahead {
+        float min; // inches
+        float max; // inches
+        float time = 0.3; // seconds of travel at the commanded speed added to min
+        float radiusFraction = 1; // at most this fraction of the tightest turn radius ahead, 0 to ignore curvature
+};
+
+// One leg of a motion chain: drive toward a point, handing off to the next leg exitRange inches before it
+struct ChainStep {
+        float x; // inches
+        float y; // inches
+        float exitRange = 6; // inches, also the size of the blended corner. ignored on the last leg
+        bool forwards = true;
+        float maxSpeed = 127;
+};
+
+// An action fired once a motion has traveled a distance, from the motion's own loop
+struct Marker {
+        const char* name; // for the log
+        float distance; // inches along the motion, degrees for turns
+        std::function<void()> action; // runs on the motion task, so keep it short (set a piston, an intake)
+        int index = -1; // follow only: fire at this path point instead of a distance
+};
+
+enum class TuneAxis {
+    LATERAL, // drive back and forth
+    ANGULAR // turn back and forth in place
+};
+
+// RAMSETE gains. the usual b = 2 and zeta = 0.7 are for meters; b scales with 1 / length^2, so in
+// inches it is 2 * 0.0254^2
+struct RamseteParams {
+        bool forwards = true;
+        float b = 0.0013; // 1/inches^2, larger converges harder
+        float zeta = 0.7; // damping, 0 to 1
+};
+
+struct WheelVelocities {
+        float left; // inches/s
+        float right; // inches/s
+};
+
+struct WheelPositions {
+        float left; // inches
+        float right; // inches
+};
+
+enum class OdomBackend {
+    LEMLIB, // lemlib's odometry: wheel travel with the IMU heading taken as exact
+    EKF // PoseFilter: wheel travel weighted by how much it is slipping, corrected by the IMU and a GPS
+};
+
+// Sensor noise for the EKF backend, as standard deviations
+struct OdomNoise {
+        float wheelSlip = 0.05; // drive motor travel, as a fraction of it
+        float trackingWheel = 0.01; // tracking wheel travel, as a fraction of it
+        float lateralSlip = 0.02; // sideways travel without a horizontal wheel, as a fraction of the forward travel
+        float minimumTravel = 0.002; // inches on every wheel every update, so a still robot is not certain
+        float imuHeading = 0.5; // degrees
+        float slipRate = 20; // degrees/s the wheels' turn rate can differ from the IMU's before their noise doubles
+        float gpsMinimum = 0.5; // inches, floor on the GPS's own error estimate
+        float gpsGate = 3; // GPS readings further than this many standard deviations from the estimate are ignored
+};
+
+// Chassis::characterize test settings
+struct SysIdParams {
+        float rampRate = 1; // volts/s for the quasistatic tests
+        float stepVoltage = 6; // volts for the dynamic tests
+        float spinVoltage = 4; // volts for the spin tests
+        float maxDistance = 48; // inches a drive test may cover before it stops
+        float spinTurns = 2; // turns in each spin test
+        int testTimeout = 10000; // ms of driving in each test at most
+        int measureTime = 10000; // ms stopped after the first test, to measure how far it went
+        int restTime = 1000; // ms stopped between the other tests
+};
+
+// lemlib::Chassis with feedforward velocity control. The lemlib motions keep working unchanged;
+// the motions added here command voltages from a feedforward model of each drive side, with
+// the lemlib PIDs as feedback
+class Chassis : public lemlib::Chassis {
+    public:
+        Chassis(lemlib::Drivetrain drivetrain, lemlib::ControllerSettings linearSettings,
+                lemlib::ControllerSettings angularSettings, lemlib::OdomSensors sensors, DriveFeedforward feedforward,
+                lemlib::DriveCurve* throttleCurve = &lemlib::defaultDriveCurve,
+                lemlib::DriveCurve* steerCurve = &lemlib::defaultDriveCurve);
+
+        // drive each side at a velocity (inches/s) and acceleration (inches/s^2): feedforward plus
+        // proportional feedback on the measured wheel velocity
+        void driveVelocity(float left, float right, float leftAccel = 0, float rightAccel = 0);
+        // wheel surface velocities from the drive motor encoders
+        WheelVelocities getWheelVelocities();
+        // wheel travel from the drive motor encoders
+        WheelPositions getWheelPositions();
+
+        // lemlib::Chassis::moveToPoint, or with a profile set, a time-parameterized straight line move
+        // that tracks the profile with feedforward and uses the lateral PID on the position error
+        void moveToPoint(float x, float y, int timeout, MoveToPointParams params = {}, bool async = true);
+        // lemlib::Chassis::turnToHeading, or with a profile set, a profiled turn in place with
+        // feedforward and the angular PID on the heading error
+        void turnToHeading(float theta, int timeout, TurnToHeadingParams params = {}, bool async = true);
+        // lemlib::Chassis::follow for text assets. binary assets (see motion/pathView.hpp) are followed
+        // straight from flash by pure pursuit at the planned velocities, with feedforward
+        void follow(const asset& path, float lookahead, int timeout, bool forwards = true, bool async = true);
+        // follow a spline path with the same pure pursuit. the path is sampled and its velocities
+        // planned from the feedforward model when the motion starts
+        void follow(const SplinePath& path, float lookahead, int timeout, bool forwards = true, bool async = true);
+        // follow with a lookahead that adapts to the planned speed and the path curvature, both read
+        // from the path. text assets have neither, so they follow at the minimum lookahead
+        void follow(const asset& path, AdaptiveLookahead lookahead, int timeout, bool forwards = true,
+                    bool async = true);
+        void follow(const SplinePath& path, AdaptiveLookahead lookahead, int timeout, bool forwards = true,
+                    bool async = true);
+
+        // gain schedules for the feedback of the profiled moves and turns and moveChain, replacing the fixed
+        // lateral or angular gains. the lateral schedule is keyed on the distance left (inches) and the drive
+        // speed (inches/s), the angular one on the heading error (degrees) and the turn rate (degrees/s).
+        // an empty schedule goes back to the fixed gains. set between motions, not during one
+        void setLateralSchedule(GainSchedule schedule);
+        void setAngularSchedule(GainSchedule schedule);
+
+        // markers for the next motion started here (profiled moves and turns, follow with a binary or
+        // spline path, followTrajectory, moveChain). markers past where it ends do not fire. a motion that
+        // goes to lemlib instead (no profile, a text path), is skipped or is cancelled drops them with a
+        // warning, so they never fire during a later motion
+        void setMarkers(std::vector<Marker> markers);
+
+        // relay autotune: ramp the output until the robot moves, then oscillate about the current pose with
+        // +-amplitude (127 scale) until four cycles are measured, fit the plant, and propose PD gains for the
+        // lateral or angular controller. prints the result as a ControllerSettings line for globals.cpp,
+        // keeping the current exit conditions, unless the gains do not settle the fitted plant (settleTime is
+        // negative then). blocks, and needs room to move a few inches or degrees either way
+        TuneResult autotune(TuneAxis axis, TuningRule rule = TuningRule::SOME_OVERSHOOT, float amplitude = 60,
+                            int timeout = 10000);
+
+        // system identification: drive the quasistatic and dynamic tests forwards and backwards, then spin in
+        // place both ways, logging voltage, wheel position and velocity and heading every 10 ms. the log goes
+        // to the terminal after each test (printing while driving would upset the timing) as sysid lines for
+        // bin/tools/sysid, which fits the feedforward, track width and wheel diameter. blocks, and needs
+        // maxDistance inches of clear field ahead of the robot
+        void characterize(SysIdParams params = {});
+
+        // choose the odometry before calibrate. the EKF backend replaces lemlib's odometry task with its own,
+        // which fuses the drive motor encoders, any tracking wheels in the OdomSensors, the IMU and, if given,
+        // a GPS. the GPS works in its own field frame, so poses are field coordinates in inches when it is used
+        void setOdomBackend(OdomBackend backend, OdomNoise noise = {}, pros::Gps* gps = nullptr);
+        // lemlib::Chassis::calibrate, starting the chosen odometry backend
+        void calibrate(bool calibrateIMU = true);
+        // pose covariance from the EKF backend, x and y in inches and theta in radians. all zeros with the lemlib
+        // backend, which does not track it
+        PoseCovariance getPoseCovariance();
+        // field frame velocity, inches/s and degrees/s, from whichever backend is running
+        lemlib::Pose getVelocity();
+
+        // distance the current motion has covered, -1 once it has finished. what waitUntil polls
+        float getDistanceTraveled() const { return distTraveled; }
+
+        const DriveFeedforward& getFeedforward() const { return feedforward; }
+        void setFeedforward(DriveFeedforward feedforward) { this->feedforward = feedforward; }
+        // drive through a list of points without stopping between them. each leg hands off to the next at
+        // the fastest velocity its corner allows, and the next leg is planned while the current one runs.
+        // a leg before a reversal or a right-angle corner stops on its point instead, as does the last one,
+        // on the lateral exit conditions
+        void moveChain(const std::vector<ChainStep>& steps, int timeout,
+                       ProfileShape profile = ProfileShape::TRAPEZOIDAL, bool async = true);
+        // time the robot along a trajectory with RAMSETE feedback on the odometry pose and feedforward on
+        // the trajectory's wheel velocities. unlike follow, the robot is where the trajectory says at each
+        // moment, so timing is repeatable. exits on the lateral exit conditions once the trajectory ends
+        void followTrajectory(const Trajectory& trajectory, int timeout, RamseteParams params = {},
+                              bool async = true);
+        // sample a spline path and plan its timing from the feedforward model
+        Trajectory planTrajectory(const SplinePath& path) const;
+    protected:
+        // send a voltage to each side, clamped to MAX_VOLTAGE. every motion here drives through this
+        void driveVoltage(float left, float right);
+        // feedforward voltage for a side velocity and acceleration, plus the velocity feedback term
+        float sideVoltage(const Feedforward& side, float velocity, float acceleration, float measured) const;
+        // build a profile over a distance in inches, filling unset limits from the feedforward model.
+        // speedScale is a lemlib maxSpeed on the 127 scale. S-curves are rest to rest, so a start or end
+        // velocity falls back to a trapezoid
+        MotionProfile linearProfile(float distance, ProfileShape shape, float maxVelocity, float maxAcceleration,
+                                    float maxJerk, float speedScale, float endVelocity = 0,
+                                    float startVelocity = 0) const;
+        // wheel travel per drive motor revolution, inches
+        float inchesPerMotorRev();
+        // fastest wheel velocity and acceleration the feedforward model allows within the headroom
+        float maxWheelVelocity() const;
+        float maxWheelAcceleration() const;
+        // the limits above as velocity planner input
+        DriveLimits driveLimits() const;
+        // set this cycle's gains from the schedules, if any. lateral sets lateralFeedback, angular sets
+        // headingFeedback and turnPID
+        void scheduleLateral(float error, const WheelVelocities& measured);
+        void scheduleAngular(float error, const WheelVelocities& measured);
+        // pure pursuit over a point list (PathView or std::vector<PathPoint>) at its planned velocities
+        template <typename Points>
+        void pursue(const Points& points, AdaptiveLookahead lookahead, int timeout, bool forwards);
+
+        // one EKF odometry update, every 10 ms on the odometry task
+        void updateOdometry();
+
+        // take the pending markers for the motion that is starting
+        void beginMarkers();
+        // drop the pending markers for a motion that cannot fire them, warning if there were any
+        void discardMarkers(const char* motion);
+        void sortMarkers();
+        void fireMarker();
+        // end of a motion loop iteration: fire the markers distTraveled has passed, then wait out the 10 ms
+        // cycle, firing any marker the current rate of travel reaches before then at its predicted time
+        void waitCycle();
+
+        DriveFeedforward feedforward;
+        // feedback for profiled turns, with the angular gains: the derivative is filtered so IMU noise does not
+        // reach the motors, and the integral unwinds when the output saturates
+        PID<FilteredDerivative<ErrorDerivative>, BackCalculationIntegral, Clamped> turnPID;
+        // lemlib::PID equivalents of lateralPID and angularPID for the profiled moves, whose gains can change
+        LemlibPID lateralFeedback;
+        LemlibPID headingFeedback;
+        GainSchedule lateralSchedule;
+        GainSchedule angularSchedule;
+        float wheelInchesPerMotorRev = 0; // computed from the cartridge on first use, see inchesPerMotorRev
+        pros::Mutex markerMutex;
+        std::vector<Marker> pendingMarkers;
+        std::vector<Marker> activeMarkers; // sorted by distance
+        std::size_t nextMarker = 0;
+        float lastDistance = 0;
+        std::uint64_t lastMarkerTime = 0;
+        OdomBackend odomBackend = OdomBackend::LEMLIB;
+        OdomNoise odomNoise;
+        pros::Gps* gps = nullptr;
+        std::unique_ptr<pros::Task> odomTask;
+        pros::Mutex odomMutex; // guards the filter, odomVelocity and the readings below
+        PoseFilter poseFilter;
+        lemlib::Pose odomVelocity = {0, 0, 0}; // inches/s and degrees/s
+        lemlib::Pose lastPublished = {0, 0, 0}; // the last pose set on lemlib, radians
+        WheelPositions lastWheels = {0, 0};
+        float lastTracking[4] = {}; // vertical1, vertical2, horizontal1, horizontal2
+        float lastImu = 0; // IMU rotation, radians, the last finite reading
+        bool imuMissed = false; // the last update had no IMU reading
+        float imuOffset = 0; // filter heading minus IMU rotation
+        float lastGpsX = NAN, lastGpsY = NAN;
+        std::uint32_t lastOdomUpdate = 0;
+};
+
+} // namespace motion
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cmath>
+
+namespace motion {
+
+// Largest voltage a V5 motor accepts
+constexpr float MAX_VOLTAGE = 12;
+// Share of MAX_VOLTAGE planned motions may spend on feedforward; the rest is left for feedback
+constexpr float FEEDFORWARD_HEADROOM = 0.8;
+
+// Permanent magnet DC motor model for one side of the drivetrain:
+// volts = kS * sgn(velocity) + kV * velocity + kA * acceleration, with velocity in inches/s
+struct Feedforward {
+        float kS = 0; // volts to overcome static friction
+        float kV = 0; // volts per inch/s
+        float kA = 0; // volts per inch/s^2
+
+        float calculate(float velocity, float acceleration = 0) const {
+            float friction = velocity > 0 ? kS : velocity < 0 ? -kS : 0;
+            return friction + kV * velocity + kA * acceleration;
+        }
+
+        // top speed when holding a voltage, in inches/s
+        float maxVelocity(float voltage = MAX_VOLTAGE) const { return kV > 0 ? (voltage - kS) / kV : 0; }
+
+        // acceleration available at a velocity when holding a voltage, in inches/s^2
+        float maxAcceleration(float velocity, float voltage = MAX_VOLTAGE) const {
+            if (kA <= 0) return INFINITY;
+            return (voltage - kS - kV * std::fabs(velocity)) / kA;
+        }
+
+        // deceleration available at a velocity when braking with a voltage, in inches/s^2
+        float maxDeceleration(float velocity, float voltage = MAX_VOLTAGE) const {
+            if (kA <= 0) return INFINITY;
+            return (voltage + kS + kV * std::fabs(velocity)) / kA;
+        }
+};
+
+// Feedforward for each side, plus proportional feedback on the measured wheel velocity error
+struct DriveFeedforward {
+        Feedforward left;
+        Feedforward right;
+        float kP = 0; // volts per inch/s of velocity error
+};
+
+} // namespace motion
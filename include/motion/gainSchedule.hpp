@@ -0,0 +1,28 @@
+#pragma once
+
+#include <vector>
+#include "motion/pid.hpp"
+
+namespace motion {
+
+// PID gains looked up by error magnitude and speed, interpolated between the entries of a small table.
+// Both axes are clamped at their ends, so the table only needs to span the useful range
+class GainSchedule {
+    public:
+        // no schedule: the fixed gains stay in use
+        GainSchedule() = default;
+        // errors and speeds ascending; gains row by row, one row per error and one column per speed
+        GainSchedule(std::vector<float> errors, std::vector<float> speeds, std::vector<PIDGains> gains);
+        // keyed on error only
+        GainSchedule(std::vector<float> errors, std::vector<PIDGains> gains);
+
+        bool empty() const { return gains.empty(); }
+        // bilinear interpolation at |error| and |speed|
+        PIDGains lookup(float error, float speed) const;
+    private:
+        std::vector<float> errors;
+        std::vector<float> speeds;
+        std::vector<PIDGains> gains;
+};
+
+} // namespace motion
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "motion/velocityPlanner.hpp"
+
+namespace motion {
+
+// parameter along the segment a-b where it leaves a circle, or -1 if it does not cross it
+float circleIntersect(const PathPoint& a, const PathPoint& b, float x, float y, float radius);
+
+// where a point projects onto a path
+struct PathProjection {
+        std::size_t segment = 0; // segment from point segment to point segment + 1
+        float t = 0; // 0 to 1 along the segment
+        float distance = INFINITY; // from the query point
+};
+
+// Spatial index over the segments of a point list (PathView or std::vector<PathPoint>) for pure pursuit.
+// Segments are bucketed into a uniform grid once per path, so the closest point and lookahead queries
+// only look at the segments near the robot instead of scanning the rest of the path every cycle.
+// The index keeps no copy of the points; queries take the same point list it was built from
+class PathIndex {
+    public:
+        // how many segments past the previous closest one the closest point may move per query. keeps the
+        // search monotone and stops it jumping to a later part of the path that passes nearby
+        static constexpr std::size_t CLOSEST_WINDOW = 32;
+
+        template <typename Points> PathIndex(const Points& points, float cellSize = 12);
+
+        // closest point on the path at or after the previous closest segment
+        template <typename Points>
+        PathProjection closest(const Points& points, float x, float y, std::size_t from) const;
+        // first segment at or after from where the path leaves a circle, and the point where it does
+        template <typename Points>
+        bool lookahead(const Points& points, float x, float y, float radius, std::size_t from,
+                       std::size_t& segment, PathPoint& target) const;
+    private:
+        // cell range covering a box, clamped to the grid
+        struct CellRange {
+                int minColumn, minRow, maxColumn, maxRow;
+        };
+
+        CellRange cellRange(float minX, float minY, float maxX, float maxY) const;
+        std::size_t cell(int column, int row) const { return std::size_t(row) * columns + column; }
+        // segment ids in a cell
+        const std::uint32_t* cellBegin(std::size_t index) const { return segments.data() + cellStart[index]; }
+        const std::uint32_t* cellEnd(std::size_t index) const { return segments.data() + cellStart[index + 1]; }
+        static void project(const PathPoint& a, const PathPoint& b, float x, float y, std::size_t segment,
+                            PathProjection& best);
+
+        float originX = 0, originY = 0;
+        float cellSize;
+        int columns = 0, rows = 0;
+        std::size_t segmentCount = 0;
+        std::vector<std::uint32_t> cellStart; // offsets into segments, one per cell plus one
+        std::vector<std::uint32_t> segments;
+};
+
+template <typename Points>
+PathIndex::PathIndex(const Points& points, float cellSize)
+    : cellSize(cellSize) {
+    const std::size_t count = points.size();
+    if (count < 2 || cellSize <= 0) return;
+    segmentCount = count - 1;
+    float minX = INFINITY, minY = INFINITY, maxX = -INFINITY, maxY = -INFINITY;
+    for (std::size_t i = 0; i < count; i++) {
+        const PathPoint point = points[i];
+        minX = std::min(minX, point.x), minY = std::min(minY, point.y);
+        maxX = std::max(maxX, point.x), maxY = std::max(maxY, point.y);
+    }
+    originX = minX, originY = minY;
+    columns = int((maxX - minX) / cellSize) + 1;
+    rows = int((maxY - minY) / cellSize) + 1;
+    cellStart.assign(std::size_t(columns) * rows + 1, 0);
+
+    // counting pass, then a fill pass into one flat array
+    auto forEachCell = [&](std::size_t i, auto&& fn) {
+        const PathPoint a = points[i], b = points[i + 1];
+        const CellRange range =
+            cellRange(std::min(a.x, b.x), std::min(a.y, b.y), std::max(a.x, b.x), std::max(a.y, b.y));
+        for (int row = range.minRow; row <= range.maxRow; row++) {
+            for (int column = range.minColumn; column <= range.maxColumn; column++) fn(cell(column, row));
+        }
+    };
+    for (std::size_t i = 0; i < segmentCount; i++) forEachCell(i, [&](std::size_t c) { cellStart[c + 1]++; });
+    for (std::size_t c = 1; c < cellStart.size(); c++) cellStart[c] += cellStart[c - 1];
+    segments.resize(cellStart.back());
+    std::vector<std::uint32_t> fill(cellStart.begin(), cellStart.end() - 1);
+    for (std::size_t i = 0; i < segmentCount; i++) forEachCell(i, [&](std::size_t c) { segments[fill[c]++] = i; });
+}
+
+template <typename Points>
+PathProjection PathIndex::closest(const Points& points, float x, float y, std::size_t from) const {
+    PathProjection best;
+    if (segmentCount == 0) return best;
+    from = std::min(from, segmentCount - 1);
+    const std::size_t to = std::min(from + CLOSEST_WINDOW, segmentCount);
+    // segments in the window that pass through the cells around the robot
+    const CellRange range = cellRange(x - cellSize, y - cellSize, x + cellSize, y + cellSize);
+    for (int row = range.minRow; row <= range.maxRow; row++) {
+        for (int column = range.minColumn; column <= range.maxColumn; column++) {
+            const std::size_t c = cell(column, row);
+            for (const std::uint32_t* it = cellBegin(c); it != cellEnd(c); it++) {
+                if (*it >= from && *it < to) project(points[*it], points[*it + 1], x, y, *it, best);
+            }
+        }
+    }
+    // every segment within a cell of the robot was a candidate. further off the path than that, one
+    // outside the cells could be closer, so scan the window directly
+    if (best.distance > cellSize) {
+        for (std::size_t i = from; i < to; i++) project(points[i], points[i + 1], x, y, i, best);
+    }
+    return best;
+}
+
+template <typename Points>
+bool PathIndex::lookahead(const Points& points, float x, float y, float radius, std::size_t from,
+                          std::size_t& segment, PathPoint& target) const {
+    // the earliest crossing wins, as in a scan along the path
+    std::size_t earliest = segmentCount;
+    float earliestT = -1;
+    const CellRange range = cellRange(x - radius, y - radius, x + radius, y + radius);
+    for (int row = range.minRow; row <= range.maxRow; row++) {
+        for (int column = range.minColumn; column <= range.maxColumn; column++) {
+            const std::size_t c = cell(column, row);
+            for (const std::uint32_t* it = cellBegin(c); it != cellEnd(c); it++) {
+                if (*it < from || *it >= earliest) continue;
+                const float t = circleIntersect(points[*it], points[*it + 1], x, y, radius);
+                if (t >= 0) earliest = *it, earliestT = t;
+            }
+        }
+    }
+    if (earliest == segmentCount) return false;
+    const PathPoint a = points[earliest], b = points[earliest + 1];
+    segment = earliest;
+    target = {a.x + earliestT * (b.x - a.x), a.y + earliestT * (b.y - a.y)};
+    return true;
+}
+
+} // namespace motion
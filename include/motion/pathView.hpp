@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "lemlib/asset.hpp"
+#include "motion/velocityPlanner.hpp"
+
+namespace motion {
+
+// Binary path asset: a PathHeader followed by count PackedPathPoint records, little endian,
+// generated at build time by tools/pathPlanner.cpp
+constexpr std::uint32_t PATH_MAGIC = 0x31485450; // "PTH1"
+constexpr std::uint16_t PATH_VERSION = 1;
+constexpr float PATH_POSITION_SCALE = 100; // 0.01 inch
+constexpr float PATH_VELOCITY_SCALE = 100; // 0.01 inch/s
+constexpr float PATH_CURVATURE_SCALE = 10000; // 0.0001 / inch
+
+struct __attribute__((packed)) PathHeader {
+        std::uint32_t magic;
+        std::uint16_t version;
+        std::uint16_t pointSize; // bytes per point record
+        std::uint32_t count;
+        std::int16_t minX, minY, maxX, maxY; // bounds, in position units
+        std::uint32_t checksum; // FNV-1a of the point records
+};
+
+struct __attribute__((packed)) PackedPathPoint {
+        std::int16_t x;
+        std::int16_t y;
+        std::uint16_t velocity;
+        std::int16_t curvature;
+};
+
+PackedPathPoint packPathPoint(const PathPoint& point);
+PathPoint unpackPathPoint(const PackedPathPoint& packed);
+std::uint32_t pathChecksum(const std::uint8_t* data, std::size_t size);
+
+// Read-only view over a binary path asset. Nothing is parsed or copied up front; points are decoded
+// one at a time straight from flash. The asset buffer is not necessarily aligned, so records are
+// read with memcpy
+class PathView {
+    public:
+        PathView(const std::uint8_t* data, std::size_t size);
+        explicit PathView(const asset& path)
+            : PathView(path.buf, path.size) {}
+
+        // whether an asset starts with the binary path header, as opposed to a LemLib text path
+        static bool isBinaryPath(const asset& path);
+
+        // header present and the size matches the point count
+        bool isValid() const { return valid; }
+        // checksum matches. walks every point, so call it once at startup rather than in a motion
+        bool verify() const;
+
+        std::size_t size() const { return count; }
+        PathPoint operator[](std::size_t index) const;
+
+        float getMinX() const { return header.minX / PATH_POSITION_SCALE; }
+        float getMinY() const { return header.minY / PATH_POSITION_SCALE; }
+        float getMaxX() const { return header.maxX / PATH_POSITION_SCALE; }
+        float getMaxY() const { return header.maxY / PATH_POSITION_SCALE; }
+    private:
+        const std::uint8_t* points = nullptr;
+        std::size_t count = 0;
+        PathHeader header = {};
+        bool valid = false;
+};
+
+} // namespace motion
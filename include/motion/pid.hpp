@@ -0,0 +1,155 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+
+namespace motion {
+
+// Gains in lemlib::PID form: the integral and derivative are per 10 ms update, not per second
+struct PIDGains {
+        float kP = 0;
+        float kI = 0;
+        float kD = 0;
+};
+
+// Policies for motion::PID. Each is a small struct holding its own parameters and state; a PID built
+// from the plain ones compiles down to lemlib::PID and pays nothing for the features it leaves out
+
+// derivative of the error, as lemlib::PID does. kicks when the target jumps
+struct ErrorDerivative {
+        float update(float error, float) {
+            const float derivative = error - previous;
+            previous = error;
+            return derivative;
+        }
+        void reset() { previous = 0; }
+
+        float previous = 0;
+};
+
+// derivative of the negated measurement: the same as ErrorDerivative while the target holds still,
+// without the spike when it moves
+struct MeasurementDerivative {
+        float update(float, float measurement) {
+            const float derivative = started ? previous - measurement : 0;
+            previous = measurement;
+            started = true;
+            return derivative;
+        }
+        void reset() { started = false; }
+
+        float previous = 0;
+        bool started = false;
+};
+
+// first order low pass over another derivative policy, for noisy odometry and IMU readings
+template <typename Inner> struct FilteredDerivative {
+        float update(float error, float measurement) {
+            filtered += alpha * (inner.update(error, measurement) - filtered);
+            return filtered;
+        }
+        void reset() {
+            inner.reset();
+            filtered = 0;
+        }
+
+        float alpha = 0.5; // weight of the newest sample, 1 for no filtering
+        Inner inner = {};
+        float filtered = 0;
+};
+
+// lemlib::PID's integral: zeroed outside windupRange and, optionally, when the error changes sign
+struct WindupResetIntegral {
+        float update(float error) {
+            value += error;
+            if (signFlipReset && (error < 0) != (previous < 0)) value = 0;
+            if (windupRange != 0 && std::fabs(error) > windupRange) value = 0;
+            previous = error;
+            return value;
+        }
+        void saturated(float, float) {}
+        void reset() { value = previous = 0; }
+
+        float windupRange = 0;
+        bool signFlipReset = false;
+        float value = 0;
+        float previous = 0;
+};
+
+// back-calculation anti-windup: when the output saturates, unwind the integral by the excess so it
+// stops growing against the limit and recovers as soon as the error allows
+struct BackCalculationIntegral {
+        float update(float error) { return value += error; }
+        // called with how far the clamp cut the output
+        void saturated(float excess, float kI) {
+            if (kI != 0) value -= tracking * excess / kI;
+        }
+        void reset() { value = 0; }
+
+        float tracking = 1; // fraction of the excess unwound per update
+        float value = 0;
+};
+
+struct Unclamped {
+        float apply(float output) const { return output; }
+};
+
+struct Clamped {
+        float apply(float output) const { return std::clamp(output, -limit, limit); }
+
+        float limit = 127;
+};
+
+// PID assembled from policies. Units follow lemlib::PID: the integral and derivative are per update, not
+// per second, so gains carry over
+template <typename Derivative = ErrorDerivative, typename Integral = WindupResetIntegral,
+          typename Output = Unclamped>
+class PID {
+    public:
+        PID(float kP, float kI, float kD, Derivative derivative = {}, Integral integral = {}, Output output = {})
+            : kP(kP),
+              kI(kI),
+              kD(kD),
+              derivative(derivative),
+              integral(integral),
+              output(output) {}
+
+        // error only: the measurement is taken as -error, which is exact while the target holds still
+        float update(float error) { return step(error, -error); }
+        // target and measurement, for derivative on measurement
+        float update(float target, float measurement) { return step(target - measurement, measurement); }
+
+        void reset() {
+            derivative.reset();
+            integral.reset();
+        }
+
+        // takes effect on the next update, keeping the integral and derivative state
+        void setGains(PIDGains gains) {
+            kP = gains.kP;
+            kI = gains.kI;
+            kD = gains.kD;
+        }
+        PIDGains getGains() const { return {kP, kI, kD}; }
+    private:
+        float step(float error, float measurement) {
+            const float i = integral.update(error);
+            const float d = derivative.update(error, measurement);
+            const float raw = error * kP + i * kI + d * kD;
+            const float clamped = output.apply(raw);
+            if (clamped != raw) integral.saturated(raw - clamped, kI);
+            return clamped;
+        }
+
+        float kP;
+        float kI;
+        float kD;
+        [[no_unique_address]] Derivative derivative;
+        [[no_unique_address]] Integral integral;
+        [[no_unique_address]] Output output;
+};
+
+// behaves exactly like lemlib::PID(kP, kI, kD, windupRange, signFlipReset)
+using LemlibPID = PID<ErrorDerivative, WindupResetIntegral, Unclamped>;
+
+} // namespace motion
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <array>
+
+namespace motion {
+
+// Pose covariance, row by row over x (inches), y (inches) and theta (radians)
+using PoseCovariance = std::array<float, 9>;
+
+// Odometry travel over one update, in the robot frame, with its uncertainty
+struct OdometryStep {
+        float forward; // inches along the heading
+        float lateral; // inches to the left, like lemlib's horizontal tracking wheels
+        float turn; // radians clockwise
+        float forwardVariance;
+        float lateralVariance;
+        float turnVariance;
+        float forwardTurnCovariance = 0; // forward and turn both from the drive sides share their noise
+};
+
+// Extended Kalman filter over the pose (x, y, theta clockwise from +y, lemlib's convention). Wheel travel
+// predicts, absolute measurements (an IMU heading, a GPS position) correct, and the covariance says how
+// far to trust the result
+class PoseFilter {
+    public:
+        PoseFilter() = default;
+
+        // start over at a pose. theta in radians
+        void reset(float x, float y, float theta, float positionVariance = 0, float headingVariance = 0);
+        // dead reckon through one step of wheel travel, arcing at the mean heading
+        void predict(const OdometryStep& step);
+        // correct with an absolute heading in radians
+        void updateHeading(float theta, float variance);
+        // correct with an absolute position in inches. returns false, changing nothing, if it is more than
+        // gate standard deviations from the estimate
+        bool updatePosition(float x, float y, float variance, float gate = 3);
+
+        float getX() const { return x; }
+        float getY() const { return y; }
+        float getTheta() const { return theta; }
+        const PoseCovariance& getCovariance() const { return covariance; }
+    private:
+        float x = 0;
+        float y = 0;
+        float theta = 0;
+        PoseCovariance covariance = {};
+};
+
+} // namespace motion
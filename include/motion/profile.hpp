@@ -0,0 +1,49 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+namespace motion {
+
+struct ProfileState {
+        float position = 0;
+        float velocity = 0;
+        float acceleration = 0;
+};
+
+// Time-parameterized 1D motion profile over a distance, built from up to seven constant-jerk segments.
+// Units are whatever the caller uses consistently (inches or degrees, per second)
+class MotionProfile {
+    public:
+        // accelerate at maxAcceleration to maxVelocity (or as fast as the distance allows), cruise,
+        // then decelerate. the start and end velocities let consecutive motions hand off without stopping
+        static MotionProfile trapezoidal(float distance, float maxVelocity, float maxAcceleration,
+                                         float startVelocity = 0, float endVelocity = 0);
+        // rest to rest profile that also limits jerk, so acceleration ramps instead of stepping.
+        // a jerk limit of 0 gives a trapezoidal profile
+        static MotionProfile sCurve(float distance, float maxVelocity, float maxAcceleration, float maxJerk);
+
+        // state at a time in seconds, clamped to the ends of the profile
+        ProfileState sample(float t) const;
+        float getDuration() const { return duration; }
+        float getDistance() const { return end.position; }
+    private:
+        struct Segment {
+                float start; // seconds from the profile start
+                float duration;
+                float jerk;
+                ProfileState initial;
+        };
+
+        MotionProfile(float startVelocity);
+        // append a segment that starts at the end of the previous one with the given acceleration
+        void add(float duration, float acceleration, float jerk);
+        static ProfileState integrate(const ProfileState& initial, float jerk, float t);
+
+        std::array<Segment, 7> segments = {};
+        std::size_t segmentCount = 0;
+        float duration = 0;
+        ProfileState end;
+};
+
+} // namespace motion
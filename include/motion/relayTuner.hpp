@@ -0,0 +1,118 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include "motion/pid.hpp"
+
+namespace motion {
+
+// Integrator plus lag and dead time with saturation and a deadband: a drivetrain's position (inches or
+// degrees) driven by a 127 scale output. The autotuner fits this to its experiment, and the host tools run
+// it as a stand-in for the robot
+class PlantModel {
+    public:
+        PlantModel(float gain, float delay, float lag = 0, float deadband = 0, float dt = 0.01);
+
+        // apply an output for one step and return the new position
+        float update(float output);
+        float getPosition() const { return position; }
+        void reset();
+    private:
+        float gain; // units/s per unit of output
+        float lag; // seconds
+        float deadband; // outputs below this do not move the plant
+        float dt;
+        std::vector<float> pending; // outputs still in the dead time, oldest first
+        std::size_t head = 0;
+        float velocity = 0;
+        float position = 0;
+};
+
+// one update of a relay experiment
+struct RelaySample {
+        float output; // what update returned
+        float error; // what it was given, measured before that output was applied
+};
+
+// Relay feedback experiment. The output first ramps up from 0 until the plant moves, which finds the
+// deadband. Then driving it at +-amplitude against the error makes the plant oscillate at the frequency
+// where its phase lag reaches 180 degrees; the period and size of that oscillation give the ultimate gain
+// and period. Every update is kept so the plant can be fitted to the whole response afterwards
+class RelayTuner {
+    public:
+        // hysteresis (in error units) keeps sensor noise from chattering the relay. rampRate is in output
+        // per second
+        RelayTuner(float amplitude, float hysteresis = 0, int cycles = 4, float rampRate = 40);
+
+        // relay output for the error (setpoint - measurement) at a time in seconds. call it every 10 ms,
+        // the step the plant fit assumes
+        float update(float t, float error);
+        bool done() const { return completed >= cycles; }
+
+        // ultimate gain (output per unit of error) and period (seconds), from the describing function
+        float getUltimateGain() const;
+        float getUltimatePeriod() const;
+        // peak error of the oscillation
+        float getOscillation() const;
+        float getHysteresis() const { return hysteresis; }
+        float getAmplitude() const { return amplitude; }
+        const std::vector<RelaySample>& getTrace() const { return trace; }
+        // index into the trace where the measured cycles start
+        std::size_t getCyclesStart() const { return cyclesStart; }
+    private:
+        float amplitude;
+        float hysteresis;
+        int cycles;
+        float rampRate;
+        float rampStart = -1; // time of the first update
+        float rampDirection = 1;
+        float startError = 0;
+        bool ramping = true;
+        std::vector<RelaySample> trace;
+        std::size_t cyclesStart = 0;
+        float output = 0;
+        float lastRise = -1; // time of the last switch to a positive output
+        bool settled = false; // past the first cycle
+        int completed = 0; // full cycles measured
+        float periodSum = 0;
+        float peakSum = 0;
+        float minError = 0, maxError = 0; // over the current cycle
+};
+
+enum class TuningRule {
+    CLASSIC, // Ziegler-Nichols, fast with overshoot
+    SOME_OVERSHOOT,
+    NO_OVERSHOOT
+};
+
+struct TuneResult {
+        float ultimateGain;
+        float ultimatePeriod; // seconds
+        // identified plant, a PlantModel: position = gain / (s (lag s + 1)) * e^(-delay s) * output, where
+        // outputs under the deadband do not move it
+        float plantGain; // units/s per unit of output
+        float plantDelay; // seconds
+        float plantLag; // seconds
+        float plantDeadband; // output
+        PIDGains gains;
+        // seconds to settle a step on the identified plant, negative if the gains do not settle it. a
+        // proposal that does not settle should not be used
+        float settleTime;
+};
+
+// fit a PlantModel to a finished relay experiment: gain, dead time and lag by least squares over the
+// measured cycles, then the deadband over the ramp that started it
+void identifyPlant(const RelayTuner& relay, TuneResult& result);
+
+// identify the plant from a finished relay experiment and propose PD gains for it (it already integrates,
+// so the integral stays 0). the settle time is simulated on the identified plant, deadband included, for
+// a step within settleError for settleTimeout
+TuneResult proposeGains(const RelayTuner& relay, TuningRule rule, float step, float settleError,
+                        float settleTimeout);
+
+// seconds for a lemlib-style PID to bring a plant within settleError of a step and hold it there for
+// settleTimeout, or -1 if it has not within maxTime
+float simulateSettle(PlantModel plant, PIDGains gains, float step, float settleError, float settleTimeout,
+                     float maxTime = 10);
+
+} // namespace motion
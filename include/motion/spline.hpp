@@ -0,0 +1,56 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <vector>
+#include "motion/velocityPlanner.hpp"
+
+namespace motion {
+
+// A point the path passes through, with the direction it passes through it
+struct Waypoint {
+        float x; // inches
+        float y; // inches
+        float heading; // degrees, clockwise from +y like the lemlib pose
+        float tangent = 0; // tangent length in inches, 0 for the distance to the neighbouring waypoint
+};
+
+struct ControlPoint {
+        float x; // inches
+        float y; // inches
+};
+
+// Piecewise cubic path stored as a handful of control points instead of a dense point list. Each segment
+// keeps an arc length table, so points can be looked up by distance along the path with exact curvature
+class SplinePath {
+    public:
+        // cubic Hermite spline through the waypoints
+        SplinePath(const std::vector<Waypoint>& waypoints);
+        // cubic Bezier segments sharing end points: 3n + 1 control points for n segments
+        static SplinePath bezier(const std::vector<ControlPoint>& controlPoints);
+
+        float getLength() const { return length; }
+        // position and curvature at a distance along the path, clamped to its ends
+        PathPoint sample(float distance) const;
+        // points every spacing inches from start to end, with curvature but no velocity
+        std::vector<PathPoint> discretize(float spacing) const;
+    private:
+        // arc length table resolution per segment
+        static constexpr std::size_t TABLE_SIZE = 16;
+
+        struct Segment {
+                std::array<ControlPoint, 4> control;
+                float start; // arc length at the start of the segment
+                float length;
+                std::array<float, TABLE_SIZE + 1> table; // arc length at t = i / TABLE_SIZE
+        };
+
+        SplinePath() = default;
+        void addSegment(ControlPoint p0, ControlPoint p1, ControlPoint p2, ControlPoint p3);
+        static PathPoint evaluate(const Segment& segment, float t);
+
+        std::vector<Segment> segments;
+        float length = 0;
+};
+
+} // namespace motion
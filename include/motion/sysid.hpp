@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "motion/feedforward.hpp"
+
+namespace motion {
+
+// Drivetrain characterization tests, in the order Chassis::characterize runs them
+enum class SysIdTest {
+    QUASISTATIC_FORWARD, // voltage ramped slowly, so acceleration is negligible: kS and kV
+    QUASISTATIC_BACKWARD,
+    DYNAMIC_FORWARD, // voltage stepped, so acceleration dominates at first: kA
+    DYNAMIC_BACKWARD,
+    SPIN_CLOCKWISE, // in place: the effective track width
+    SPIN_COUNTERCLOCKWISE
+};
+
+// log tag for each test, e.g. "qf"
+const char* sysIdTestName(SysIdTest test);
+
+// One logged cycle of a test. positions and velocities are from the drive motor encoders with the nominal
+// wheel diameter, so they are off by the same factor as the diameter
+struct SysIdSample {
+        float time; // seconds since the test started
+        float leftVoltage; // volts commanded at the motors
+        float rightVoltage;
+        float leftPosition; // inches since the test started
+        float rightPosition;
+        float leftVelocity; // inches/s as reported by the motors
+        float rightVelocity;
+        float heading; // degrees, clockwise, continuous
+};
+
+// The drivetrain constants the log was recorded with, written once at the start of the log
+struct SysIdConfig {
+        float trackWidth; // inches
+        float wheelDiameter; // inches
+        float rpm;
+        float horizontalDrift;
+        float velocityKP; // DriveFeedforward::kP, carried through to the output
+};
+
+// Serial log lines, "sysid,config,..." and "sysid,<test>,<sample fields>", so the fit can pick them out of
+// everything else the terminal prints
+std::string formatSysIdConfig(const SysIdConfig& config);
+std::string formatSysIdSample(SysIdTest test, const SysIdSample& sample);
+
+// A parsed log: the config and the samples of each test
+struct SysIdLog {
+        bool hasConfig = false;
+        SysIdConfig config = {};
+        std::vector<SysIdSample> tests[6];
+
+        std::vector<SysIdSample>& operator[](SysIdTest test) { return tests[int(test)]; }
+        const std::vector<SysIdSample>& operator[](SysIdTest test) const { return tests[int(test)]; }
+        // parse one line, ignoring anything that is not a sysid line. returns whether it was one
+        bool parseLine(const std::string& line);
+};
+
+struct FeedforwardFit {
+        Feedforward model;
+        float rSquared; // share of the velocity variance the model explains
+        std::size_t samples; // used in the fit
+};
+
+// least squares fit of volts = kS * sgn(v) + kV * v + kA * a for one side over the four drive tests, from
+// how the velocity changes between 50 ms blocks. velocity comes from the positions, since the motors' own
+// lags. blocks with no voltage or slower than minVelocity (still breaking static friction) are left out
+FeedforwardFit fitFeedforward(const SysIdLog& log, bool left, float minVelocity = 1);
+
+// track width that makes the wheel travel match the IMU over the spin tests, inches. slip while turning
+// makes it wider than the measured one
+float fitTrackWidth(const SysIdLog& log);
+
+// encoder distance covered by a test, the mean of both sides
+float testDistance(const SysIdLog& log, SysIdTest test);
+
+} // namespace motion
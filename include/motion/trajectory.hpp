@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cmath>
+#include <vector>
+#include "motion/velocityPlanner.hpp"
+
+namespace motion {
+
+struct TrajectoryState {
+        float time = 0; // seconds from the start
+        float distance = 0; // inches along the path
+        float x = 0; // inches
+        float y = 0; // inches
+        float theta = 0; // radians, clockwise from +y like the lemlib pose
+        float velocity = 0; // inches/s
+        float angularVelocity = 0; // radians/s, clockwise
+        float acceleration = 0; // inches/s^2
+};
+
+// A path with a time for every point: the pose, velocity and turn rate the robot should have at each
+// moment. Built from a point list whose velocities are already planned (a binary path asset, or
+// planVelocities output), facing along the path. It ends at the first point after the start planned to
+// zero speed, so a path.jerryio asset's repeated end point and lookahead extension are left out
+class Trajectory {
+    public:
+        Trajectory() = default;
+        template <typename Points> explicit Trajectory(const Points& points);
+
+        // state at a time in seconds, interpolated, clamped to the ends
+        TrajectoryState sample(float t) const;
+        float getDuration() const { return states.empty() ? 0 : states.back().time; }
+        bool empty() const { return states.empty(); }
+    private:
+        // fill in headings, times, turn rates and accelerations once every point is added
+        void finish();
+
+        std::vector<TrajectoryState> states;
+};
+
+template <typename Points> Trajectory::Trajectory(const Points& points) {
+    states.reserve(points.size());
+    for (std::size_t i = 0; i < points.size(); i++) {
+        const PathPoint point = points[i];
+        TrajectoryState state;
+        state.x = point.x;
+        state.y = point.y;
+        state.velocity = point.velocity;
+        // path curvature is counter-clockwise positive
+        state.angularVelocity = -point.velocity * point.curvature;
+        states.push_back(state);
+        if (i > 0 && point.velocity <= 0) break;
+    }
+    finish();
+}
+
+} // namespace motion
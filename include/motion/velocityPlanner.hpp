@@ -0,0 +1,36 @@
+#pragma once
+
+#include <vector>
+#include "motion/feedforward.hpp"
+
+namespace motion {
+
+struct PathPoint {
+        float x; // inches
+        float y; // inches
+        float velocity = 0; // inches/s at the robot center
+        float curvature = 0; // 1/inches, positive turning counter-clockwise
+};
+
+// What each side of a differential drive can do
+struct DriveLimits {
+        float trackWidth; // inches
+        float maxWheelVelocity; // inches/s
+        float maxWheelAcceleration; // inches/s^2, the traction limit
+        float maxLateralAcceleration = 0; // inches/s^2 at the center, 0 for no limit
+        // with a kA, wheel acceleration is also limited by the voltage left at each speed
+        Feedforward left = {};
+        Feedforward right = {};
+        float voltage = MAX_VOLTAGE * FEEDFORWARD_HEADROOM;
+};
+
+// signed curvature at each point from the circle through it and its neighbours
+void computeCurvature(std::vector<PathPoint>& points);
+
+// fill in each point's velocity with the fastest profile along the path that keeps both wheels within
+// their velocity and acceleration limits, using a forward pass for acceleration and a backward pass
+// for braking. curvature must already be computed. returns the profile's duration in seconds
+float planVelocities(std::vector<PathPoint>& points, const DriveLimits& limits, float startVelocity = 0,
+                     float endVelocity = 0);
+
+} // namespace motion
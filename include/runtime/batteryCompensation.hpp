@@ -0,0 +1,65 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <initializer_list>
+#include "pros/motor_group.hpp"
+#include "pros/motors.hpp"
+
+namespace runtime {
+
+// the motor voltage command that means full duty, whatever the battery is at
+constexpr float MOTOR_FULL_SCALE_VOLTAGE = 12;
+
+// Filtered battery voltage, and the motor command that puts a wanted voltage across a motor at it.
+// A motor voltage command is really a duty cycle of the battery, so the same command drives a motor
+// faster on a fresh battery than a tired one
+class BatteryCompensation {
+    public:
+        // 127 power means nominalVoltage. below the battery voltage, so that full power is the same on every
+        // charge. the filter's time constant keeps current draw sag from feeding back into the output
+        explicit BatteryCompensation(float nominalVoltage = 11.5, float timeConstant = 0.5);
+
+        // filtered battery voltage in volts, refreshed at most every 10 ms by whichever task asks
+        float getVoltage();
+        float getNominalVoltage() const { return nominalVoltage; }
+        // millivolt command for a voltage across the motor, clamped to full duty
+        std::int32_t toCommand(float volts);
+        // millivolt command for a 127 scale power, as a fraction of the nominal voltage
+        std::int32_t powerToCommand(std::int32_t power);
+    private:
+        const float nominalVoltage;
+        const float timeConstant;
+        std::atomic<float> voltage = 0;
+        std::atomic<std::uint32_t> lastUpdate = 0;
+};
+
+// Motor group whose output does not depend on the battery charge: move() is a fraction of the nominal
+// voltage, and move_voltage() is the voltage across the motors. lemlib drives its motor groups through
+// move(), so a Drivetrain built on these is compensated too
+class CompensatedMotorGroup : public pros::MotorGroup {
+    public:
+        CompensatedMotorGroup(BatteryCompensation& battery, std::initializer_list<std::int8_t> ports,
+                              pros::v5::MotorGears gearset = pros::v5::MotorGears::invalid,
+                              pros::v5::MotorUnits encoderUnits = pros::v5::MotorUnits::invalid);
+
+        std::int32_t move(std::int32_t power) const override;
+        std::int32_t move_voltage(std::int32_t voltage) const override;
+    private:
+        BatteryCompensation& battery;
+};
+
+// CompensatedMotorGroup for a single motor
+class CompensatedMotor : public pros::Motor {
+    public:
+        CompensatedMotor(BatteryCompensation& battery, std::int8_t port,
+                         pros::v5::MotorGears gearset = pros::v5::MotorGears::invalid,
+                         pros::v5::MotorUnits encoderUnits = pros::v5::MotorUnits::invalid);
+
+        std::int32_t move(std::int32_t power) const override;
+        std::int32_t move_voltage(std::int32_t voltage) const override;
+    private:
+        BatteryCompensation& battery;
+};
+
+} // namespace runtime
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include "pros/misc.hpp"
+#include "runtime/seqlock.hpp"
+
+namespace runtime {
+
+// Every controller input read in one frame. Buttons are bit flags indexed from E_CONTROLLER_DIGITAL_L1
+struct ControllerFrame {
+        std::array<std::int8_t, 4> analog = {}; // indexed by controller_analog_e_t
+        std::uint16_t buttons = 0;
+        std::uint32_t time = 0; // pros::millis() when sampled
+
+        bool isHeld(pros::controller_digital_e_t button) const;
+        int getAnalog(pros::controller_analog_e_t axis) const { return analog[axis]; }
+};
+
+enum class ButtonEvent {
+    PRESS, // rising edge
+    RELEASE, // falling edge
+    HOLD, // held for the hold time, fires once per press
+    DOUBLE_TAP // second press within the double tap window
+};
+
+// Samples the controller once per frame, detects button events and dispatches bound callbacks.
+// update() and the callbacks run on one task; other tasks read the published frame with getFrame()
+class ControllerInput {
+    public:
+        ControllerInput(pros::Controller& controller, std::uint32_t holdTime = 500, std::uint32_t doubleTapTime = 300);
+
+        // register a callback. bind everything before the first update()
+        void bind(pros::controller_digital_e_t button, ButtonEvent event, std::function<void()> callback);
+        // sample an input every frame even though nothing is bound to it
+        void watch(pros::controller_digital_e_t button);
+        void watch(pros::controller_analog_e_t axis);
+
+        // sample the watched inputs, publish the frame and run callbacks for any events
+        const ControllerFrame& update();
+        // latest published frame, safe from any task
+        ControllerFrame getFrame() const { return published.read(); }
+    private:
+        struct Binding {
+                std::uint8_t index;
+                ButtonEvent event;
+                std::function<void()> callback;
+        };
+
+        void dispatch(std::uint8_t index, ButtonEvent event);
+
+        pros::Controller& controller;
+        const std::uint32_t holdTime;
+        const std::uint32_t doubleTapTime;
+        std::vector<Binding> bindings;
+        std::uint16_t buttonMask = 0;
+        std::uint8_t analogMask = 0;
+
+        ControllerFrame frame;
+        std::array<std::uint32_t, 12> pressTime = {};
+        std::uint16_t holdFired = 0;
+        std::uint16_t tapArmed = 0;
+        Seqlock<ControllerFrame> published;
+};
+
+} // namespace runtime
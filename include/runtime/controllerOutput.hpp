@@ -0,0 +1,59 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include "pros/misc.hpp"
+#include "pros/rtos.hpp"
+
+namespace runtime {
+
+constexpr std::uint8_t CONTROLLER_LINES = 3;
+constexpr std::size_t CONTROLLER_LINE_LENGTH = 19; // characters that fit on one controller line
+constexpr std::size_t MAX_QUEUED_RUMBLES = 4;
+
+// Queued controller screen and rumble output. The controller only accepts about one update every
+// 50 ms, so callers only stage what they want shown and a background task sends one update per
+// interval: the highest priority rumble first, then changed lines round robin. Staging a line that
+// has not been sent yet replaces it, so only the latest text for each line is ever sent
+class ControllerOutput {
+    public:
+        ControllerOutput(pros::Controller& controller, std::uint32_t updateInterval = 50);
+
+        // start the background task. does nothing if already started
+        void start();
+
+        // stage the text for a line, printf style. safe from any task and never waits on the controller
+        void print(std::uint8_t line, const char* fmt, ...) __attribute__((format(printf, 3, 4)));
+        void clearLine(std::uint8_t line);
+        // queue a rumble pattern ('.', '-' and ' ', up to 8 characters). higher priorities play first.
+        // when the queue is full the lowest priority pattern is dropped
+        void rumble(const char* pattern, int priority = 0);
+
+        // line updates that were replaced before they were sent
+        std::uint32_t getCoalesced() const { return coalesced; }
+    private:
+        struct Rumble {
+                std::array<char, 9> pattern;
+                int priority;
+                std::uint32_t order; // first in, first out among equal priorities
+        };
+
+        // send at most one pending update
+        void sendNext();
+
+        pros::Controller& controller;
+        const std::uint32_t updateInterval;
+        std::unique_ptr<pros::Task> task;
+        pros::Mutex mutex;
+
+        std::array<std::array<char, CONTROLLER_LINE_LENGTH + 1>, CONTROLLER_LINES> lines = {};
+        std::uint8_t dirty = 0;
+        std::uint8_t nextLine = 0;
+        std::array<Rumble, MAX_QUEUED_RUMBLES> rumbles = {};
+        std::size_t rumbleCount = 0;
+        std::uint32_t rumbleOrder = 0;
+        std::uint32_t coalesced = 0;
+};
+
+} // namespace runtime
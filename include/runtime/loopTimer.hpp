@@ -0,0 +1,47 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+namespace runtime {
+
+// Jitter histogram bucket upper bounds in microseconds; the last bucket catches everything above
+constexpr std::array<std::uint32_t, 7> JITTER_BUCKET_LIMITS = {250, 500, 1000, 2000, 5000, 10000, 20000};
+constexpr std::size_t JITTER_BUCKETS = JITTER_BUCKET_LIMITS.size() + 1;
+
+struct LoopStats {
+        std::uint32_t iterations = 0;
+        std::uint32_t overruns = 0; // iterations whose work ran past the deadline
+        std::uint32_t lastPeriod = 0; // measured wake-to-wake period, microseconds
+        std::uint32_t minPeriod = UINT32_MAX;
+        std::uint32_t maxPeriod = 0;
+        std::uint64_t totalPeriod = 0;
+        std::uint32_t lastWork = 0; // time spent between wake and the next wait(), microseconds
+        std::uint32_t maxWork = 0;
+        std::array<std::uint32_t, JITTER_BUCKETS> jitter = {}; // |period - nominal| histogram
+
+        float meanPeriod() const { return iterations ? float(totalPeriod) / iterations : 0; }
+};
+
+// Fixed-rate loop pacing against absolute deadlines, so time spent in the loop body does not
+// stretch the period. Call start() once before the loop and wait() at the end of every iteration.
+class LoopTimer {
+    public:
+        explicit LoopTimer(std::uint32_t periodMs);
+
+        // anchor the first deadline at the current time
+        void start();
+        // block until the next deadline and record timing statistics
+        void wait();
+
+        std::uint32_t getPeriod() const { return periodMs; }
+        LoopStats getStats() const { return stats; }
+        void resetStats();
+    private:
+        const std::uint32_t periodMs;
+        std::uint32_t lastWake = 0; // millisecond deadline passed to task_delay_until
+        std::uint64_t lastWakeMicros = 0;
+        LoopStats stats;
+};
+
+} // namespace runtime
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include "pros/abstract_motor.hpp"
+#include "pros/rtos.hpp"
+#include "runtime/seqlock.hpp"
+
+namespace runtime {
+
+constexpr std::size_t MAX_SAMPLED_GROUPS = 4;
+constexpr std::size_t MAX_GROUP_MOTORS = 8;
+
+// One sample of every motor in a group, in group order
+struct MotorGroupSample {
+        std::uint8_t size = 0;
+        std::array<float, MAX_GROUP_MOTORS> temperature = {}; // degrees celsius
+        std::array<std::int32_t, MAX_GROUP_MOTORS> current = {}; // milliamps
+        std::array<float, MAX_GROUP_MOTORS> velocity = {}; // rpm
+        std::array<std::uint32_t, MAX_GROUP_MOTORS> faults = {}; // motor_fault_e_t bit flags
+
+        float averageTemperature() const;
+        float maxTemperature() const;
+        std::uint32_t combinedFaults() const;
+};
+
+struct MotorSnapshot {
+        std::uint32_t time = 0; // pros::millis() when sampled, 0 before the first sample
+        std::array<MotorGroupSample, MAX_SAMPLED_GROUPS> groups = {};
+};
+
+// Background sampler that reads whole motor groups through the get_*_all() calls at a low rate
+// and publishes one snapshot, so the driver stages, GUI and logging never query the motors themselves
+class MotorSampler {
+    public:
+        // groups are published in the order given here
+        MotorSampler(std::initializer_list<pros::AbstractMotor*> groups, std::uint32_t periodMs);
+
+        void setPeriod(std::uint32_t periodMs) { this->periodMs = periodMs; }
+        // start the background task. does nothing if already started
+        void start();
+        // copy of the latest published snapshot. never blocks
+        MotorSnapshot getSnapshot() const { return snapshot.read(); }
+    private:
+        // read every group once and publish the result. only called from the sampler task
+        void sample();
+
+        std::array<pros::AbstractMotor*, MAX_SAMPLED_GROUPS> groups = {};
+        std::size_t groupCount = 0;
+        std::atomic<std::uint32_t> periodMs;
+        std::unique_ptr<pros::Task> task;
+        Seqlock<MotorSnapshot> snapshot;
+};
+
+} // namespace runtime
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include "pros/rtos.hpp"
+
+namespace runtime {
+
+constexpr std::size_t MAX_PROFILE_SECTIONS = 16;
+// four buckets per power of two, from 0 us to just over 100 ms; the last bucket catches the rest
+constexpr std::size_t PROFILE_BUCKETS = 64;
+
+struct SectionStats {
+        const char* name = nullptr;
+        std::uint32_t budget = 0; // microseconds, 0 for no watchdog
+        std::uint32_t count = 0;
+        std::uint32_t min = UINT32_MAX;
+        std::uint32_t max = 0;
+        std::uint64_t total = 0;
+        std::uint32_t overruns = 0; // samples over budget
+        std::uint32_t lastOverrun = 0; // pros::millis() of the latest overrun
+        std::array<std::uint32_t, PROFILE_BUCKETS> histogram = {};
+
+        float mean() const { return count ? float(total) / count : 0; }
+        // upper bound of the histogram bucket holding the given fraction of samples, e.g. 0.99
+        std::uint32_t percentile(float fraction) const;
+};
+
+// Fixed-size per-section timing histograms. Register sections in initialize(); afterwards each
+// section should be recorded from one task. Reads from other tasks are for display and may see a
+// sample half applied
+class Profiler {
+    public:
+        // register a section, or look up an existing one by name. returns the section id
+        std::size_t addSection(const char* name, std::uint32_t budget = 0);
+        // record one sample in microseconds, counting it as an overrun if it exceeds the budget
+        void record(std::size_t section, std::uint32_t micros);
+
+        std::size_t getSectionCount() const { return sectionCount; }
+        const SectionStats& getStats(std::size_t section) const { return sections.at(section); }
+        // total overruns across every section, for a cheap watchdog check
+        std::uint32_t getOverruns() const { return overruns; }
+        void reset();
+
+        // write a table of every section into a buffer, for the brain screen
+        void format(char* buffer, std::size_t size) const;
+        // print the table over serial
+        void dump() const;
+    private:
+        std::array<SectionStats, MAX_PROFILE_SECTIONS> sections = {};
+        std::size_t sectionCount = 0;
+        std::uint32_t overruns = 0;
+};
+
+// Times the enclosing scope into a profiler section
+class ScopedTimer {
+    public:
+        ScopedTimer(Profiler& profiler, std::size_t section)
+            : profiler(profiler),
+              section(section),
+              start(pros::micros()) {}
+
+        ~ScopedTimer() { profiler.record(section, pros::micros() - start); }
+
+        ScopedTimer(const ScopedTimer&) = delete;
+        ScopedTimer& operator=(const ScopedTimer&) = delete;
+    private:
+        Profiler& profiler;
+        const std::size_t section;
+        const std::uint64_t start;
+};
+
+} // namespace runtime
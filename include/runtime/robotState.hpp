@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstdint>
+#include "motion/chassis.hpp"
+
+namespace runtime {
+
+struct RobotState {
+        lemlib::Pose pose = {0, 0, 0}; // inches, degrees
+        lemlib::Pose velocity = {0, 0, 0}; // global frame, inches/s and degrees/s
+        motion::PoseCovariance covariance = {}; // zeros unless the EKF odometry backend is running
+        std::uint32_t time = 0; // pros::millis() when published, 0 before the first publish
+};
+
+// start the task that copies the odometry pose and speed into the published RobotState.
+// it is the only task that reads odometry for other consumers, so their reads never contend with
+// the chassis motion task. does nothing if already started
+void startStatePublisher(motion::Chassis& chassis, std::uint32_t periodMs = 10);
+
+// latest published state. never blocks
+RobotState getRobotState();
+
+} // namespace runtime
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+#include "pros/rtos.hpp"
+#include "runtime/loopTimer.hpp"
+#include "runtime/profiler.hpp"
+
+namespace runtime {
+
+// Runs registered stages at independent rates, each in its own RTOS task, so a slow
+// low-priority stage (screen, telemetry) is preempted by the motor stages instead of delaying them.
+// Stages are registered once and can be started and stopped repeatedly across competition modes.
+class Scheduler {
+    public:
+        // with a profiler, each stage is timed into a section named after it, budgeted at its period
+        explicit Scheduler(Profiler* profiler = nullptr)
+            : profiler(profiler) {}
+        Scheduler(const Scheduler&) = delete;
+        Scheduler& operator=(const Scheduler&) = delete;
+
+        // register a stage. priority is an RTOS task priority (TASK_PRIORITY_MIN..TASK_PRIORITY_MAX)
+        void addStage(const char* name, std::uint32_t periodMs, std::uint32_t priority, std::function<void()> fn);
+
+        // spawn one task per stage. does nothing if already running
+        void start();
+        // ask every stage to finish its current iteration and wait for the tasks to exit
+        void stop();
+        bool isRunning() const { return running; }
+
+        std::size_t getStageCount() const { return stages.size(); }
+        const char* getStageName(std::size_t index) const { return stages.at(index)->name; }
+        // timing of a stage. read from another task, so fields may be one iteration apart
+        LoopStats getStageStats(std::size_t index) const { return stages.at(index)->timer.getStats(); }
+    private:
+        struct Stage {
+                Stage(const char* name, std::uint32_t periodMs, std::uint32_t priority, std::function<void()> fn,
+                      std::size_t section)
+                    : name(name),
+                      priority(priority),
+                      section(section),
+                      fn(std::move(fn)),
+                      timer(periodMs) {}
+
+                const char* name;
+                std::uint32_t priority;
+                std::size_t section; // profiler section
+                std::function<void()> fn;
+                LoopTimer timer;
+                std::unique_ptr<pros::Task> task;
+        };
+
+        void run(Stage& stage);
+
+        Profiler* const profiler;
+        std::vector<std::unique_ptr<Stage>> stages;
+        std::atomic<bool> running = false;
+};
+
+} // namespace runtime
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+
+namespace runtime {
+
+// Single-writer, multi-reader publication of a trivially copyable value. Neither side ever blocks.
+// Two copies are kept and the sequence counter tells readers which one is stable, so a reader that
+// preempts a half-finished write still returns immediately with the previous value instead of
+// spinning on a writer that cannot run. A reader only retries if the writer ran during its copy.
+template <typename T> class Seqlock {
+        static_assert(std::is_trivially_copyable_v<T>, "Seqlock values are copied byte for byte");
+    public:
+        Seqlock() = default;
+        explicit Seqlock(const T& initial)
+            : buffers {initial, initial} {}
+
+        // publish a new value. only one task may write
+        void write(const T& value) {
+            std::uint32_t seq = sequence.load(std::memory_order_relaxed);
+            // odd: readers move to buffer 1 while buffer 0 is rewritten
+            sequence.store(seq + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            buffers[0] = value;
+            // even: readers move back to buffer 0 while buffer 1 catches up
+            sequence.store(seq + 2, std::memory_order_release);
+            std::atomic_thread_fence(std::memory_order_release);
+            buffers[1] = value;
+        }
+
+        // latest consistent value
+        T read() const {
+            while (true) {
+                std::uint32_t seq = sequence.load(std::memory_order_acquire);
+                T value = buffers[seq & 1];
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (sequence.load(std::memory_order_relaxed) == seq) return value;
+            }
+        }
+
+        // number of completed writes
+        std::uint32_t getVersion() const { return sequence.load(std::memory_order_acquire) / 2; }
+    private:
+        std::atomic<std::uint32_t> sequence = 0;
+        T buffers[2] = {};
+};
+
+} // namespace runtime
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+namespace gui {
+
+constexpr int STATUS_LINES = 8; // llemu lines 0-7
+constexpr std::size_t STATUS_LINE_LENGTH = 48;
+
+// Retained brain screen text. Lines are staged with print() every frame, but only lines whose
+// text changed are pushed to llemu, and at most once per render interval. Rendering from a periodic
+// stage, keep the interval somewhat under its period: at exactly the period, scheduling jitter fails
+// the check on every other frame and halves the redraw rate
+class StatusText {
+    public:
+        explicit StatusText(std::uint32_t renderInterval = 90);
+
+        // stage the text for a line, printf style. unchanged text costs a string compare
+        void print(int line, const char* fmt, ...) __attribute__((format(printf, 3, 4)));
+        void clear(int line);
+        // redraw the lines that changed since the last render, if the render interval has passed
+        void render();
+        // forget what is on screen, e.g. after other code wrote to llemu, so every line is redrawn
+        void invalidate();
+
+        std::uint32_t getRedraws() const { return redraws; }
+        std::uint32_t getRedrawsAvoided() const { return requests - redraws; }
+    private:
+        void stage(int line, const char* text);
+
+        const std::uint32_t renderInterval;
+        std::uint32_t lastRender = 0;
+        std::array<std::array<char, STATUS_LINE_LENGTH>, STATUS_LINES> staged = {};
+        std::array<std::array<char, STATUS_LINE_LENGTH>, STATUS_LINES> shown = {};
+        std::uint8_t dirty = 0;
+        std::uint32_t requests = 0; // print() and clear() calls
+        std::uint32_t redraws = 0; // lines actually written to the screen
+};
+
+} // namespace gui
@@ -4,41 +4,53 @@
 
 namespace auton_routines {
 
-void close_side_auto() {
-    controller.rumble(".-");
+// every routine and the actions it spawns run on this executor, from the autonomous task
+static Executor executor;
+
+Script close_side_auto() {
+    controller_output.rumble(".-");
     // Implement close side autonomous routine
     // Example:
-    // chassis.moveTo(x, y, theta, timeout);
-    // robot::intakeOn();
-    // pros::delay(1000);
-    // robot::intakeOff();
+    // chassis.moveToPoint(x, y, timeout);
+    // co_await traveled(chassis, 12); // intake once 12 inches in, while the drive keeps going
+    // robot::updateIntake(true, false);
+    // co_await motionDone(chassis);
+    // co_await delay(500);
+    // robot::updateIntake(false, false);
+    co_return;
 }
 
-void far_side_auto() {
-    controller.rumble("-.");
+Script far_side_auto() {
+    controller_output.rumble("-.");
     // Implement far side autonomous routine
+    co_return;
 }
 
-void skills_auto() {
-    controller.rumble("...");
+Script skills_auto() {
+    controller_output.rumble("...");
     // Implement skills autonomous routine
+    // run actions alongside the drive with executor.spawn(...) instead of a task each
+    co_return;
 }
 
 void runSelectedAutonomous() {
+    // scripts left over from an autonomous that was cut off
+    executor.clear();
     switch (selected_auto) {
         case AutoMode::CLOSE_SIDE:
-            close_side_auto();
+            executor.spawn(close_side_auto());
             break;
         case AutoMode::FAR_SIDE:
-            far_side_auto();
+            executor.spawn(far_side_auto());
             break;
         case AutoMode::SKILLS:
-            skills_auto();
+            executor.spawn(skills_auto());
             break;
         case AutoMode::OFF:
             // Do nothing or run a default routine
             break;
     }
+    executor.run();
 }
 
-}  // namespace auton_routines
\ No newline at end of file
+}  // namespace auton_routines
@@ -0,0 +1,72 @@
+#include "autonomous/script.hpp"
+#include "runtime/loopTimer.hpp"
+#include "pros/rtos.hpp"
+
+namespace auton_routines {
+
+Executor::Slot* Executor::active = nullptr;
+
+bool Condition::await_suspend(std::coroutine_handle<> handle) {
+    if (Executor::active == nullptr) {
+        while (!ready()) pros::delay(10);
+        return false;
+    }
+    Executor::active->resume = handle;
+    Executor::active->waiting = this;
+    return true;
+}
+
+bool Executor::spawn(Script script) {
+    for (Slot& slot : slots) {
+        if (!slot.script.done()) continue;
+        slot.resume = script.handle;
+        slot.waiting = nullptr;
+        slot.script = std::move(script);
+        return true;
+    }
+    return false;
+}
+
+bool Executor::tick() {
+    bool running = false;
+    for (Slot& slot : slots) {
+        if (slot.script.done()) continue;
+        if (slot.waiting == nullptr || slot.waiting->ready()) {
+            const std::coroutine_handle<> resume = slot.resume;
+            slot.waiting = nullptr;
+            active = &slot;
+            resume.resume();
+            active = nullptr;
+        }
+        running |= !slot.script.done();
+    }
+    return running;
+}
+
+void Executor::run(std::uint32_t periodMs) {
+    runtime::LoopTimer timer(periodMs);
+    timer.start();
+    while (tick()) timer.wait();
+}
+
+void Executor::clear() {
+    for (Slot& slot : slots) slot = Slot {};
+}
+
+std::size_t Executor::getRunning() const {
+    std::size_t running = 0;
+    for (const Slot& slot : slots) running += !slot.script.done();
+    return running;
+}
+
+Delay::Delay(std::uint32_t ms)
+    : deadline(pros::millis() + ms) {}
+
+bool Delay::ready() { return static_cast<std::int32_t>(pros::millis() - deadline) >= 0; }
+
+bool Traveled::ready() {
+    const float traveled = chassis.getDistanceTraveled();
+    return traveled == -1 || traveled > distance;
+}
+
+} // namespace auton_routines
@@ -2,13 +2,23 @@
 
 // Controller
 pros::Controller controller(pros::E_CONTROLLER_MASTER);
+runtime::ControllerOutput controller_output(controller);
+
+// Battery compensation: 127 power is 11.5 V at the motors on any charge
+runtime::BatteryCompensation battery_compensation(11.5);
 
 // Motor groups
-pros::MotorGroup left_mg({-1, 2, -3});
-pros::MotorGroup right_mg({8, -6, 7});
+runtime::CompensatedMotorGroup left_mg(battery_compensation, {-1, 2, -3});
+runtime::CompensatedMotorGroup right_mg(battery_compensation, {8, -6, 7});
 
 // Motors
-pros::Motor intake_mtr(9);
+runtime::CompensatedMotor intake_mtr(battery_compensation, 9);
+
+// Motor telemetry, sampled every 250 ms
+runtime::MotorSampler motor_telemetry({&left_mg, &right_mg, &intake_mtr}, 250);
+
+// Loop profiler
+runtime::Profiler loop_profiler;
 
 // Sensors
 pros::Imu inertial(19);
@@ -24,8 +34,12 @@ lemlib::ControllerSettings lateral_controller(10, 0, 3, 3, 1, 100, 3, 500, 20);
 lemlib::ControllerSettings angular_controller(2, 0, 10, 3, 1, 100, 3, 500, 0);
 lemlib::ExpoDriveCurve throttle_curve(3, 10, 1.038);
 lemlib::ExpoDriveCurve steer_curve(3, 10, 1.038);
+// kS (V), kV (V per in/s), kA (V per in/s^2) per side and velocity kP (V per in/s).
+// Estimated from the 480 rpm, 3.25" drive (about 82 in/s at 12 V) until the drive is characterized
+motion::DriveFeedforward drive_feedforward{{0.8, 0.137, 0.02}, {0.8, 0.137, 0.02}, 0.05};
 
-lemlib::Chassis chassis(drivetrain, lateral_controller, angular_controller, sensors, &throttle_curve, &steer_curve);
+motion::Chassis chassis(drivetrain, lateral_controller, angular_controller, sensors, drive_feedforward,
+                        &throttle_curve, &steer_curve);
 
 // Autonomous mode
 AutoMode selected_auto = AutoMode::OFF;
\ No newline at end of file
@@ -3,26 +3,158 @@
 #include "robot/robot.hpp"
 #include "screen/gui.hpp"
 #include "autonomous/routines.hpp"
+#include "runtime/controllerInput.hpp"
+#include "runtime/robotState.hpp"
+#include "runtime/scheduler.hpp"
+#include "screen/statusText.hpp"
 
 using namespace lemlib;
 using namespace pros;
 
+// Driver control stages, registered once in initialize()
+static runtime::Scheduler driver_tasks(&loop_profiler);
+
+// Profiler sections inside the stages, registered in initialize()
+static std::size_t input_section, drive_section, status_section, gui_section;
+static std::atomic<bool> profile_dump_requested = false;
+
+// Controller input, sampled once per drive stage iteration
+static runtime::ControllerInput driver_input(controller);
+
+// Brain screen text, redrawn only when a line changes. The render interval is a little under the
+// screen stage period, so a stage that runs a few ms early still redraws
+static gui::StatusText status_text(90);
+
+// State shared between driver stages
+static std::atomic<bool> reverse_drive = false;
+static bool screen_reversed = false; // screen stage only
+static std::chrono::steady_clock::time_point match_start;
+static bool timer_marked = false;
+
+// Drive: samples the controller, runs button bindings and drives, 100 Hz
+static void driveStage() {
+  runtime::ControllerFrame input;
+  {
+    runtime::ScopedTimer timer(loop_profiler, input_section);
+    input = driver_input.update();
+  }
+
+  // Apply drive control
+  runtime::ScopedTimer timer(loop_profiler, drive_section);
+  robot::updateDrive(input.getAnalog(pros::E_CONTROLLER_ANALOG_LEFT_Y),
+                     input.getAnalog(pros::E_CONTROLLER_ANALOG_RIGHT_Y),
+                     reverse_drive);
+}
+
+// Intake, 100 Hz
+static void intakeStage() {
+  runtime::ControllerFrame input = driver_input.getFrame();
+  robot::updateIntake(input.isHeld(pros::E_CONTROLLER_DIGITAL_R1),
+                      input.isHeld(pros::E_CONTROLLER_DIGITAL_R2));
+}
+
+// Brain screen, match timer and GUI, 10 Hz. The only stage that touches LVGL
+static void screenStage() {
+  // Check if 1 minute 30 seconds have passed
+  if (!timer_marked) {
+    auto elapsed_time = std::chrono::duration_cast<std::chrono::seconds>(
+                            std::chrono::steady_clock::now() - match_start)
+                            .count();
+    if (elapsed_time >= 90) { //  1 minute 30 seconds of 1m 45s match
+      timer_marked = true;
+      controller_output.rumble("..", 1); // Vibrate controller when 15 seconds left
+    }
+  }
+
+  bool reversed = reverse_drive;
+  if (reversed != screen_reversed) {
+    screen_reversed = reversed;
+    lv_obj_set_style_bg_color(lv_scr_act(),
+                              reversed ? lv_color_make(255, 0, 0)     // red
+                                       : lv_color_make(120, 0, 255), // purple
+                              LV_PART_MAIN);
+  }
+
+  // Serial dump of the loop profile, requested with X
+  if (profile_dump_requested.exchange(false)) loop_profiler.dump();
+
+  {
+    runtime::ScopedTimer status_timer(loop_profiler, status_section);
+
+    // Drive direction
+    status_text.print(0, reversed ? "REVERSE" : "FORWARD");
+
+    // Temperatures from the latest motor snapshot
+    runtime::MotorSnapshot motors = motor_telemetry.getSnapshot();
+    status_text.print(1, "Left Temp: %.1f°C",
+                      motors.groups[LEFT_DRIVE_GROUP].averageTemperature());
+    status_text.print(2, "Right Temp: %.1fC",
+                      motors.groups[RIGHT_DRIVE_GROUP].averageTemperature());
+    status_text.print(3, "Intake Temp: %.1f°C",
+                      motors.groups[INTAKE_GROUP].averageTemperature());
+
+    // Drive stage timing
+    runtime::LoopStats drive_stats = driver_tasks.getStageStats(0);
+    status_text.print(4, "Drive loop: %.1f ms, %u overruns",
+                      drive_stats.meanPeriod() / 1000.0,
+                      static_cast<unsigned>(drive_stats.overruns));
+
+    // Pose from the published robot state, never waits on odometry
+    runtime::RobotState state = runtime::getRobotState();
+    status_text.print(5, "X: %.1f Y: %.1f H: %.1f", state.pose.x, state.pose.y,
+                      state.pose.theta);
+
+    status_text.render(); // Only changed lines are redrawn
+  }
+
+  // Update GUI if needed
+  runtime::ScopedTimer gui_timer(loop_profiler, gui_section);
+  gui::updateGUI();
+}
+
 // Define autonomous routines
-void close_side_auto() { controller.rumble(".-"); }
-void far_side_auto() { controller.rumble("-."); }
-void skills_auto() { controller.rumble("..."); }
+void close_side_auto() { controller_output.rumble(".-"); }
+void far_side_auto() { controller_output.rumble("-."); }
+void skills_auto() { controller_output.rumble("..."); }
 
 // Initialization function
 void initialize() {
   pros::lcd::initialize(); // initialize brain screen
   pros::lcd::set_text(1, "Initializing...");
   robot::initChassis();    // initialize and calibrate chassis
+  motor_telemetry.start(); // sample motor telemetry in the background
+  runtime::startStatePublisher(chassis); // publish pose for lock-free readers
+  controller_output.start(); // rate-limited controller screen and rumble
 
   gui::initializeGUI(); // initialize GUI
+
+  // Driver bindings
+  driver_input.watch(pros::E_CONTROLLER_ANALOG_LEFT_Y);
+  driver_input.watch(pros::E_CONTROLLER_ANALOG_RIGHT_Y);
+  driver_input.watch(pros::E_CONTROLLER_DIGITAL_R1); // intake in
+  driver_input.watch(pros::E_CONTROLLER_DIGITAL_R2); // intake out
+  driver_input.bind(pros::E_CONTROLLER_DIGITAL_B, runtime::ButtonEvent::PRESS,
+                    [] { reverse_drive = !reverse_drive; }); // toggle reverse drive
+  driver_input.bind(pros::E_CONTROLLER_DIGITAL_L1, runtime::ButtonEvent::PRESS,
+                    robot::toggleMogoClamp); // mogo clamp
+
+  driver_input.bind(pros::E_CONTROLLER_DIGITAL_X, runtime::ButtonEvent::PRESS,
+                    [] { profile_dump_requested = true; }); // dump loop profile
+
+  // Register driver control stages: motor stages preempt screen work
+  driver_tasks.addStage("drive", 10, TASK_PRIORITY_DEFAULT + 2, driveStage);
+  driver_tasks.addStage("intake", 10, TASK_PRIORITY_DEFAULT + 2, intakeStage);
+  driver_tasks.addStage("screen", 100, TASK_PRIORITY_DEFAULT - 1, screenStage);
+  input_section = loop_profiler.addSection("input");
+  drive_section = loop_profiler.addSection("updateDrive");
+  status_section = loop_profiler.addSection("status");
+  gui_section = loop_profiler.addSection("updateGUI");
 }
 
 // Disabled function
 void disabled() {
+  driver_tasks.stop(); // Stop driver stages before releasing the motors
+
   // Turn off all motors
   left_mg.move(0);
   right_mg.move(0);
@@ -35,6 +167,8 @@ void competition_initialize() {}
 
 // Autonomous function
 void autonomous() {
+  driver_tasks.stop(); // Never share the motors with driver stages
+
   auto start_time = std::chrono::high_resolution_clock::now();
 
   auton_routines::runSelectedAutonomous();
@@ -55,83 +189,21 @@ void autonomous() {
   pros::lcd::print(0, "Auto time: %.2f s", duration.count());
 
   // Optionally, display on controller
-  controller.print(0, 0, "Auto: %.2f s", duration.count());
+  controller_output.print(0, "Auto: %.2f s", duration.count());
 }
 
 // Operator control function
 void opcontrol() {
   lv_obj_set_style_bg_color(lv_scr_act(), lv_color_make(120, 0, 255),
                             LV_PART_MAIN); // Set screen to purple
-  controller.rumble(".");
-  // Initialize a timer variable
-  std::chrono::steady_clock::time_point start_time =
-      std::chrono::steady_clock::now();
-  bool timer_marked = false;
-  bool reverse_drive = false;
-
-  while (true) {
-    // Check if 1 minute 30 seconds have passed
-    if (!timer_marked) {
-      auto current_time = std::chrono::steady_clock::now();
-      auto elapsed_time = std::chrono::duration_cast<std::chrono::seconds>(
-                              current_time - start_time)
-                              .count();
-      if (elapsed_time >= 90) { //  1 minute 30 seconds of 1m 45s match
-        timer_marked = true;
-        controller.rumble(".."); // Vibrate controller when 15 seconds left
-      }
-    }
-
-    int leftY = controller.get_analog(pros::E_CONTROLLER_ANALOG_LEFT_Y);
-    int rightY = controller.get_analog(pros::E_CONTROLLER_ANALOG_RIGHT_Y);
-
-    // Calculate average temperatures
-    double avg_left_temp =
-        (left_mg.get_temperature(0) + left_mg.get_temperature(1) +
-         left_mg.get_temperature(2)) /
-        3.0;
-    double avg_right_temp =
-        (right_mg.get_temperature(0) + right_mg.get_temperature(1) +
-         right_mg.get_temperature(2)) /
-        3.0;
-    double intake_temp = intake_mtr.get_temperature();
-
-    // Update LCD with temperature information
-    pros::lcd::clear();
-    pros::lcd::print(0, "Left Temp: %.1f°C", avg_left_temp);
-    pros::lcd::print(1, "Right Temp: %.1fC", avg_right_temp);
-    pros::lcd::print(2, "Intake Temp: %.1f°C", intake_temp);
-
-    // Intake controls
-    bool intakeIn = controller.get_digital(pros::E_CONTROLLER_DIGITAL_R1);
-    bool intakeOut = controller.get_digital(pros::E_CONTROLLER_DIGITAL_R2);
-    robot::updateIntake(intakeIn, intakeOut);
-
-    // Toggle reverse drive
-    if (controller.get_digital_new_press(pros::E_CONTROLLER_DIGITAL_B)) {
-      reverse_drive = !reverse_drive;
-      if (reverse_drive) {
-        lv_obj_set_style_bg_color(lv_scr_act(), lv_color_make(255, 0, 0),
-                                  LV_PART_MAIN); // Set screen to red
-      } else {
-        lv_obj_set_style_bg_color(lv_scr_act(), lv_color_make(120, 0, 255),
-                                  LV_PART_MAIN); // Set screen to purple
-      }
-    }
-
-    // Apply drive control
-    robot::updateDrive(leftY, rightY, reverse_drive);
-
-    // Update LCD with drive direction
-    pros::lcd::set_text(0, reverse_drive ? "REVERSE" : "FORWARD");
-
-    // Mogo clamp control
-    if (controller.get_digital_new_press(pros::E_CONTROLLER_DIGITAL_L1)) {
-      robot::toggleMogoClamp();
-    }
-
-    gui::updateGUI(); // Update GUI if needed
-
-    pros::delay(20); // Run every 20 ms (50 Hz)
-  }
-}
\ No newline at end of file
+  controller_output.rumble(".");
+  // Initialize the match timer
+  match_start = std::chrono::steady_clock::now();
+  timer_marked = false;
+  reverse_drive = false;
+  screen_reversed = false;
+  status_text.invalidate(); // Autonomous may have written to the screen
+
+  // Each stage now runs in its own task at its own rate; opcontrol can return
+  driver_tasks.start();
+}
@@ -0,0 +1,65 @@
+#include "motion/chassis.hpp"
+#include <cmath>
+#include <cstdio>
+#include "lemlib/util.hpp"
+#include "pros/rtos.hpp"
+
+namespace motion {
+
+TuneResult Chassis::autotune(TuneAxis axis, TuningRule rule, float amplitude, int timeout) {
+    requestMotionStart();
+    // were all motions cancelled?
+    if (!motionRunning) return {};
+
+    const bool lateral = axis == TuneAxis::LATERAL;
+    // hysteresis a little above the odometry and IMU noise
+    RelayTuner relay(amplitude, lateral ? 0.1 : 0.5, 4);
+    const lemlib::Pose start = getPose();
+    const float dirX = std::sin(lemlib::degToRad(start.theta)), dirY = std::cos(lemlib::degToRad(start.theta));
+    const std::uint32_t startTime = pros::millis();
+    while (pros::millis() - startTime < std::uint32_t(timeout) && motionRunning && !relay.done()) {
+        const lemlib::Pose pose = getPose();
+        const float t = (pros::millis() - startTime) / 1000.0f;
+        // oscillate about where the robot started
+        if (lateral) {
+            const float progress = (pose.x - start.x) * dirX + (pose.y - start.y) * dirY;
+            const float output = pidToVolts(relay.update(t, -progress));
+            driveVoltage(output, output);
+        } else {
+            const float output = pidToVolts(relay.update(t, lemlib::angleError(start.theta, pose.theta, false)));
+            driveVoltage(output, -output);
+        }
+        pros::delay(10);
+    }
+    driveVoltage(0, 0);
+    endMotion();
+
+    if (!relay.done()) {
+        std::printf("autotune: no sustained oscillation, try a larger amplitude\n");
+        return {};
+    }
+    // predict settling a typical move with the current exit conditions
+    const lemlib::ControllerSettings& settings = lateral ? lateralSettings : angularSettings;
+    const TuneResult result =
+        proposeGains(relay, rule, lateral ? 24 : 90, settings.smallError, settings.smallErrorTimeout / 1000);
+    std::printf("autotune %s: Ku %.3f, Tu %.3f s, plant gain %.3f, delay %.3f s, lag %.3f s, deadband %.2f\n",
+                lateral ? "lateral" : "angular", result.ultimateGain, result.ultimatePeriod, result.plantGain,
+                result.plantDelay, result.plantLag, result.plantDeadband);
+    if (result.settleTime < 0) {
+        // near the target the P term alone cannot clear the deadband, so the robot would stall short of it
+        std::printf("autotune: kP %.3f, kD %.3f do not settle the identified plant, not proposing them. raise kP "
+                    "or add kI\n",
+                    result.gains.kP, result.gains.kD);
+        return result;
+    }
+    std::printf("autotune: settles a %g step in %.2f s on the identified plant\n", lateral ? 24.0 : 90.0,
+                result.settleTime);
+    // ready to paste into globals.cpp
+    std::printf("lemlib::ControllerSettings %s_controller(%.3f, %.3f, %.3f, %g, %g, %g, %g, %g, %g);\n",
+                lateral ? "lateral" : "angular", result.gains.kP, result.gains.kI, result.gains.kD,
+                settings.windupRange, settings.smallError, settings.smallErrorTimeout, settings.largeError,
+                settings.largeErrorTimeout, settings.slew);
+    return result;
+}
+
+} // namespace motion
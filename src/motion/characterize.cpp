@@ -0,0 +1,82 @@
+#include "motion/chassis.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include "pros/rtos.hpp"
+#include "runtime/loopTimer.hpp"
+
+namespace motion {
+
+void Chassis::characterize(SysIdParams params) {
+    requestMotionStart();
+    // were all motions cancelled?
+    if (!motionRunning) return;
+
+    std::printf("%s\n", formatSysIdConfig({drivetrain.trackWidth, drivetrain.wheelDiameter, drivetrain.rpm,
+                                           drivetrain.horizontalDrift, feedforward.kP})
+                            .c_str());
+    // samples are kept until the robot has stopped, then printed, so the serial port does not hold up the loop
+    std::vector<SysIdSample> samples;
+    samples.reserve(params.testTimeout / 10 + 100);
+
+    for (SysIdTest test : {SysIdTest::QUASISTATIC_FORWARD, SysIdTest::QUASISTATIC_BACKWARD,
+                           SysIdTest::DYNAMIC_FORWARD, SysIdTest::DYNAMIC_BACKWARD, SysIdTest::SPIN_CLOCKWISE,
+                           SysIdTest::SPIN_COUNTERCLOCKWISE}) {
+        const bool spin = test == SysIdTest::SPIN_CLOCKWISE || test == SysIdTest::SPIN_COUNTERCLOCKWISE;
+        const bool quasistatic = test == SysIdTest::QUASISTATIC_FORWARD || test == SysIdTest::QUASISTATIC_BACKWARD;
+        const float sign = test == SysIdTest::QUASISTATIC_BACKWARD || test == SysIdTest::DYNAMIC_BACKWARD ||
+                                   test == SysIdTest::SPIN_COUNTERCLOCKWISE
+                               ? -1
+                               : 1;
+        const WheelPositions start = getWheelPositions();
+        const float startHeading = getPose().theta;
+        const std::uint64_t startTime = pros::micros();
+        float stoppedAt = -1; // test time the drive was cut, seconds
+        samples.clear();
+
+        runtime::LoopTimer loop(10);
+        loop.start();
+        while (motionRunning) {
+            const float t = (pros::micros() - startTime) / 1e6f;
+            const WheelPositions position = getWheelPositions();
+            const WheelVelocities velocity = getWheelVelocities();
+            const float heading = getPose().theta;
+            const float left = position.left - start.left, right = position.right - start.right;
+
+            // drive until the test has gone far enough, then log the robot coasting to a stop
+            if (stoppedAt < 0) {
+                const bool far = spin ? std::fabs(heading - startHeading) >= 360 * params.spinTurns
+                                      : std::fabs(left + right) / 2 >= params.maxDistance;
+                if (far || t * 1000 >= params.testTimeout) stoppedAt = t;
+            }
+            float voltage = 0;
+            if (stoppedAt < 0) {
+                voltage = sign * (spin ? params.spinVoltage : quasistatic ? params.rampRate * t : params.stepVoltage);
+            } else if (t - stoppedAt > 0.5) {
+                break;
+            }
+            // driveVoltage goes through the battery compensated motors, so these are the volts at the motors
+            const float leftVoltage = std::clamp(voltage, -MAX_VOLTAGE, MAX_VOLTAGE);
+            const float rightVoltage = spin ? -leftVoltage : leftVoltage;
+            driveVoltage(leftVoltage, rightVoltage);
+            samples.push_back({t, leftVoltage, rightVoltage, left, right, velocity.left, velocity.right, heading});
+            loop.wait();
+        }
+        driveVoltage(0, 0);
+
+        for (std::size_t i = 0; i < samples.size(); i++) {
+            std::printf("%s\n", formatSysIdSample(test, samples[i]).c_str());
+            // give the serial port time to drain
+            if (i % 50 == 49) pros::delay(5);
+        }
+        if (!motionRunning) break;
+        if (test == SysIdTest::QUASISTATIC_FORWARD) {
+            std::printf("sysid: measure how far the robot went for --measured, %.1f in on the encoders\n",
+                        (samples.back().leftPosition + samples.back().rightPosition) / 2);
+        }
+        pros::delay(test == SysIdTest::QUASISTATIC_FORWARD ? params.measureTime : params.restTime);
+    }
+    endMotion();
+}
+
+} // namespace motion
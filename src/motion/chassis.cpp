@@ -0,0 +1,144 @@
+#include "motion/chassis.hpp"
+#include <algorithm>
+#include <cmath>
+#include "lemlib/util.hpp"
+#include "pros/motor_group.hpp"
+
+namespace motion {
+
+Chassis::Chassis(lemlib::Drivetrain drivetrain, lemlib::ControllerSettings linearSettings,
+                 lemlib::ControllerSettings angularSettings, lemlib::OdomSensors sensors,
+                 DriveFeedforward feedforward, lemlib::DriveCurve* throttleCurve, lemlib::DriveCurve* steerCurve)
+    : lemlib::Chassis(drivetrain, linearSettings, angularSettings, sensors, throttleCurve, steerCurve),
+      feedforward(feedforward),
+      turnPID(angularSettings.kP, angularSettings.kI, angularSettings.kD),
+      lateralFeedback(linearSettings.kP, linearSettings.kI, linearSettings.kD, {},
+                      {linearSettings.windupRange, true}),
+      headingFeedback(angularSettings.kP, angularSettings.kI, angularSettings.kD, {},
+                      {angularSettings.windupRange, true}) {}
+
+void Chassis::setLateralSchedule(GainSchedule schedule) {
+    lateralSchedule = std::move(schedule);
+    // without a schedule the last scheduled gains would stick, so go back to the configured ones
+    if (lateralSchedule.empty()) lateralFeedback.setGains({lateralSettings.kP, lateralSettings.kI, lateralSettings.kD});
+}
+
+void Chassis::setAngularSchedule(GainSchedule schedule) {
+    angularSchedule = std::move(schedule);
+    if (angularSchedule.empty()) {
+        const PIDGains gains = {angularSettings.kP, angularSettings.kI, angularSettings.kD};
+        headingFeedback.setGains(gains);
+        turnPID.setGains(gains);
+    }
+}
+
+void Chassis::scheduleLateral(float error, const WheelVelocities& measured) {
+    if (lateralSchedule.empty()) return;
+    lateralFeedback.setGains(lateralSchedule.lookup(error, (measured.left + measured.right) / 2));
+}
+
+void Chassis::scheduleAngular(float error, const WheelVelocities& measured) {
+    if (angularSchedule.empty()) return;
+    const float turnRate = lemlib::radToDeg((measured.left - measured.right) / drivetrain.trackWidth);
+    const PIDGains gains = angularSchedule.lookup(error, turnRate);
+    headingFeedback.setGains(gains);
+    turnPID.setGains(gains);
+}
+
+static float cartridgeRpm(pros::MotorGears gears) {
+    switch (gears) {
+        case pros::MotorGears::red: return 100;
+        case pros::MotorGears::green: return 200;
+        default: return 600;
+    }
+}
+
+float Chassis::inchesPerMotorRev() {
+    if (wheelInchesPerMotorRev == 0) {
+        const float wheelRevsPerMotorRev = drivetrain.rpm / cartridgeRpm(drivetrain.leftMotors->get_gearing());
+        wheelInchesPerMotorRev = wheelRevsPerMotorRev * drivetrain.wheelDiameter * M_PI;
+    }
+    return wheelInchesPerMotorRev;
+}
+
+static double average(const std::vector<double>& values) {
+    if (values.empty()) return 0.0;
+    double sum = 0;
+    for (double value : values) sum += value;
+    return sum / values.size();
+}
+
+WheelVelocities Chassis::getWheelVelocities() {
+    // motor rpm to inches/s
+    const float scale = inchesPerMotorRev() / 60;
+    return {float(average(drivetrain.leftMotors->get_actual_velocity_all()) * scale),
+            float(average(drivetrain.rightMotors->get_actual_velocity_all()) * scale)};
+}
+
+// motor revolutions in whatever encoder units the group is set to
+static double motorRevolutions(pros::MotorGroup& motors) {
+    const double position = average(motors.get_position_all());
+    switch (motors.get_encoder_units()) {
+        case pros::MotorEncoderUnits::rotations: return position;
+        case pros::MotorEncoderUnits::counts: return position * cartridgeRpm(motors.get_gearing()) / 180000;
+        default: return position / 360;
+    }
+}
+
+WheelPositions Chassis::getWheelPositions() {
+    return {float(motorRevolutions(*drivetrain.leftMotors) * inchesPerMotorRev()),
+            float(motorRevolutions(*drivetrain.rightMotors) * inchesPerMotorRev())};
+}
+
+float Chassis::sideVoltage(const Feedforward& side, float velocity, float acceleration, float measured) const {
+    return side.calculate(velocity, acceleration) + feedforward.kP * (velocity - measured);
+}
+
+void Chassis::driveVelocity(float left, float right, float leftAccel, float rightAccel) {
+    const WheelVelocities measured = getWheelVelocities();
+    driveVoltage(sideVoltage(feedforward.left, left, leftAccel, measured.left),
+                 sideVoltage(feedforward.right, right, rightAccel, measured.right));
+}
+
+float Chassis::maxWheelVelocity() const {
+    const float voltage = MAX_VOLTAGE * FEEDFORWARD_HEADROOM;
+    return std::min(feedforward.left.maxVelocity(voltage), feedforward.right.maxVelocity(voltage));
+}
+
+float Chassis::maxWheelAcceleration() const {
+    // acceleration still available halfway to top speed
+    const float voltage = MAX_VOLTAGE * FEEDFORWARD_HEADROOM;
+    const float velocity = maxWheelVelocity() / 2;
+    const float acceleration = std::min(feedforward.left.maxAcceleration(velocity, voltage),
+                                        feedforward.right.maxAcceleration(velocity, voltage));
+    // without a kA the model cannot limit acceleration, so reach top speed in half a second
+    return std::isfinite(acceleration) ? acceleration : maxWheelVelocity() * 2;
+}
+
+DriveLimits Chassis::driveLimits() const {
+    DriveLimits limits = {drivetrain.trackWidth, maxWheelVelocity(), maxWheelAcceleration()};
+    limits.left = feedforward.left;
+    limits.right = feedforward.right;
+    return limits;
+}
+
+MotionProfile Chassis::linearProfile(float distance, ProfileShape shape, float maxVelocity, float maxAcceleration,
+                                     float maxJerk, float speedScale, float endVelocity,
+                                     float startVelocity) const {
+    float velocity = maxVelocity > 0 ? maxVelocity : maxWheelVelocity();
+    velocity = std::min(velocity, maxWheelVelocity() * std::clamp(speedScale, 0.0f, 127.0f) / 127);
+    const float acceleration = maxAcceleration > 0 ? maxAcceleration : maxWheelAcceleration();
+    if (shape == ProfileShape::S_CURVE && endVelocity == 0 && startVelocity == 0) {
+        return MotionProfile::sCurve(distance, velocity, acceleration, maxJerk > 0 ? maxJerk : acceleration * 5);
+    }
+    return MotionProfile::trapezoidal(distance, velocity, acceleration, startVelocity, endVelocity);
+}
+
+void Chassis::driveVoltage(float left, float right) {
+    left = std::clamp(left, -MAX_VOLTAGE, MAX_VOLTAGE);
+    right = std::clamp(right, -MAX_VOLTAGE, MAX_VOLTAGE);
+    drivetrain.leftMotors->move_voltage(left * 1000);
+    drivetrain.rightMotors->move_voltage(right * 1000);
+}
+
+} // namespace motion
@@ -0,0 +1,189 @@
+#include "motion/chassis.hpp"
+#include <algorithm>
+#include <cmath>
+#include "lemlib/logger/logger.hpp"
+#include "lemlib/timer.hpp"
+#include "lemlib/util.hpp"
+#include "motion/pathIndex.hpp"
+#include "motion/pathView.hpp"
+#include "pros/rtos.hpp"
+
+namespace motion {
+
+// lookahead for the commanded speed, shortened to fit the tightest turn coming up within it
+template <typename Points>
+static float lookaheadDistance(const Points& points, std::size_t segment, float velocity,
+                               const AdaptiveLookahead& lookahead) {
+    if (lookahead.max <= lookahead.min) return lookahead.min;
+    float distance = std::clamp(lookahead.min + lookahead.time * std::fabs(velocity), lookahead.min, lookahead.max);
+    if (lookahead.radiusFraction <= 0) return distance;
+    float curvature = std::fabs(points[segment].curvature);
+    float ahead = 0;
+    for (std::size_t i = segment; i + 1 < points.size() && ahead < distance; i++) {
+        const PathPoint a = points[i], b = points[i + 1];
+        curvature = std::max(curvature, std::fabs(b.curvature));
+        ahead += std::hypot(b.x - a.x, b.y - a.y);
+    }
+    if (curvature > 0) distance = std::min(distance, lookahead.radiusFraction / curvature);
+    return std::clamp(distance, lookahead.min, lookahead.max);
+}
+
+template <typename Points>
+void Chassis::pursue(const Points& points, AdaptiveLookahead lookahead, int timeout, bool forwards) {
+    const bool adaptive = lookahead.max > lookahead.min;
+    distTraveled = 0;
+    const std::size_t last = points.size() - 1;
+    // the robot stops at the first point after the start planned to zero speed, usually the last one.
+    // anything past it (an older asset's repeated end point and lookahead extension) is never reached
+    std::size_t end = last;
+    for (std::size_t i = 1; i < last; i++) {
+        if (points[i].velocity <= 0) {
+            end = i;
+            break;
+        }
+    }
+    beginMarkers();
+    // markers at path points fire at the distance along the path to that point
+    if (std::any_of(activeMarkers.begin(), activeMarkers.end(), [](const Marker& m) { return m.index >= 0; })) {
+        float distance = 0;
+        for (std::size_t i = 0; i <= last; i++) {
+            for (Marker& marker : activeMarkers) {
+                if (marker.index == int(i)) marker.distance = distance;
+            }
+            if (i < last) distance += std::hypot(points[i + 1].x - points[i].x, points[i + 1].y - points[i].y);
+        }
+        sortMarkers();
+    }
+    // built once per path, so the searches below do not grow with its length
+    const PathIndex index(points);
+    PathProjection closest;
+    float segmentStart = 0; // distance along the path to the start of the closest segment
+    std::size_t lookaheadSegment = 0;
+    PathPoint target = points[0];
+    lemlib::Timer timer(timeout);
+    while (!timer.isDone() && motionRunning) {
+        lemlib::Pose pose = getPose(true);
+        if (!forwards) pose.theta += M_PI;
+
+        // closest point on the path, never moving backwards along it
+        const std::size_t previous = closest.segment;
+        closest = index.closest(points, pose.x, pose.y, previous);
+        for (std::size_t i = previous; i < closest.segment; i++) {
+            segmentStart += std::hypot(points[i + 1].x - points[i].x, points[i + 1].y - points[i].y);
+        }
+        const PathPoint current = points[closest.segment], next = points[closest.segment + 1];
+        const float step = std::hypot(next.x - current.x, next.y - current.y);
+        distTraveled = segmentStart + closest.t * step;
+        if (closest.segment >= end || (closest.segment + 1 == end && closest.t >= 1)) break;
+
+        // planned velocity at the closest point, and the acceleration toward the next one
+        // the faster of the two, so a path planned from a standstill still starts moving
+        const float velocity = std::max(current.velocity, next.velocity);
+        const float acceleration =
+            step > 0 ? (next.velocity * next.velocity - current.velocity * current.velocity) / (2 * step) : 0;
+
+        // lookahead point: where the path first leaves the lookahead circle past the closest point. a
+        // lookahead that can shrink searches from the closest segment, as the last lookahead point may
+        // now be outside the circle
+        const float radius = lookaheadDistance(points, closest.segment, velocity, lookahead);
+        const std::size_t from = adaptive ? closest.segment : std::max(closest.segment, lookaheadSegment);
+        const bool found = index.lookahead(points, pose.x, pose.y, radius, from, lookaheadSegment, target);
+        // near the end the circle contains the rest of the path
+        if (!found && std::hypot(points[end].x - pose.x, points[end].y - pose.y) < radius) {
+            target = points[end];
+        }
+
+        // curvature of the arc to the lookahead point, positive turning clockwise like the heading
+        const float dx = target.x - pose.x, dy = target.y - pose.y;
+        const float lateral = dx * std::cos(pose.theta) - dy * std::sin(pose.theta);
+        const float distanceSquared = dx * dx + dy * dy;
+        const float curvature = distanceSquared > 0 ? 2 * lateral / distanceSquared : 0;
+
+        const float scale = drivetrain.trackWidth / 2 * curvature;
+        if (forwards) {
+            driveVelocity(velocity * (1 + scale), velocity * (1 - scale), acceleration * (1 + scale),
+                          acceleration * (1 - scale));
+        } else {
+            // the sides swap when the robot drives backwards
+            driveVelocity(-velocity * (1 - scale), -velocity * (1 + scale), -acceleration * (1 - scale),
+                          -acceleration * (1 + scale));
+        }
+
+        waitCycle();
+    }
+
+    // stop the drivetrain
+    driveVoltage(0, 0);
+    // set distTraveled to -1 to indicate that the function has finished
+    distTraveled = -1;
+    endMotion();
+}
+
+
+void Chassis::follow(const asset& path, float lookahead, int timeout, bool forwards, bool async) {
+    follow(path, AdaptiveLookahead {lookahead, lookahead}, timeout, forwards, async);
+}
+
+void Chassis::follow(const SplinePath& path, float lookahead, int timeout, bool forwards, bool async) {
+    follow(path, AdaptiveLookahead {lookahead, lookahead}, timeout, forwards, async);
+}
+
+void Chassis::follow(const asset& path, AdaptiveLookahead lookahead, int timeout, bool forwards, bool async) {
+    // text assets go to lemlib's pure pursuit, which only has a fixed lookahead
+    if (!PathView::isBinaryPath(path)) {
+        discardMarkers("follow with a text path");
+        lemlib::Chassis::follow(path, lookahead.min, timeout, forwards, async);
+        return;
+    }
+    const PathView points(path);
+    if (!points.isValid() || points.size() < 2) {
+        lemlib::infoSink()->error("Binary path is corrupt or empty! Skipping motion");
+        discardMarkers("A skipped motion");
+        return;
+    }
+    requestMotionStart();
+    // were all motions cancelled?
+    if (!motionRunning) {
+        discardMarkers("A cancelled motion");
+        return;
+    }
+    // if the function is async, run it in a new task
+    if (async) {
+        pros::Task task(
+            [this, &path, lookahead, timeout, forwards] { follow(path, lookahead, timeout, forwards, false); });
+        endMotion();
+        pros::delay(10); // delay to give the task time to start
+        return;
+    }
+
+    pursue(points, lookahead, timeout, forwards);
+}
+
+void Chassis::follow(const SplinePath& path, AdaptiveLookahead lookahead, int timeout, bool forwards, bool async) {
+    if (path.getLength() <= 0) {
+        lemlib::infoSink()->error("Spline path is empty! Skipping motion");
+        discardMarkers("A skipped motion");
+        return;
+    }
+    requestMotionStart();
+    // were all motions cancelled?
+    if (!motionRunning) {
+        discardMarkers("A cancelled motion");
+        return;
+    }
+    // if the function is async, run it in a new task
+    if (async) {
+        pros::Task task(
+            [this, path, lookahead, timeout, forwards] { follow(path, lookahead, timeout, forwards, false); });
+        endMotion();
+        pros::delay(10); // delay to give the task time to start
+        return;
+    }
+
+    // sample the spline and plan velocities for it now, rather than storing a point list per path
+    std::vector<PathPoint> points = path.discretize(SPLINE_SPACING);
+    planVelocities(points, driveLimits());
+    pursue(points, lookahead, timeout, forwards);
+}
+
+} // namespace motion
@@ -0,0 +1,88 @@
+#include "motion/chassis.hpp"
+#include <cmath>
+#include "lemlib/logger/logger.hpp"
+#include "lemlib/timer.hpp"
+#include "pros/rtos.hpp"
+
+namespace motion {
+
+// sin(x) / x, 1 at 0
+static float sinc(float x) { return std::fabs(x) < 1e-4 ? 1 - x * x / 6 : std::sin(x) / x; }
+
+Trajectory Chassis::planTrajectory(const SplinePath& path) const {
+    std::vector<PathPoint> points = path.discretize(SPLINE_SPACING);
+    planVelocities(points, driveLimits());
+    return Trajectory(points);
+}
+
+void Chassis::followTrajectory(const Trajectory& trajectory, int timeout, RamseteParams params, bool async) {
+    if (trajectory.empty()) {
+        lemlib::infoSink()->error("Trajectory is empty! Skipping motion");
+        discardMarkers("A skipped motion");
+        return;
+    }
+    requestMotionStart();
+    // were all motions cancelled?
+    if (!motionRunning) {
+        discardMarkers("A cancelled motion");
+        return;
+    }
+    // if the function is async, run it in a new task
+    if (async) {
+        pros::Task task([this, trajectory, timeout, params] { followTrajectory(trajectory, timeout, params, false); });
+        endMotion();
+        pros::delay(10); // delay to give the task time to start
+        return;
+    }
+
+    lateralSmallExit.reset();
+    lateralLargeExit.reset();
+    distTraveled = 0;
+    beginMarkers();
+    const float direction = params.forwards ? 1 : -1;
+    lemlib::Timer timer(timeout);
+    const std::uint32_t startTime = pros::millis();
+    while (!timer.isDone() && motionRunning) {
+        const float t = (pros::millis() - startTime) / 1000.0f;
+        TrajectoryState setpoint = trajectory.sample(t);
+        distTraveled = setpoint.distance;
+        // driving backwards, the robot faces away from the direction of travel
+        if (!params.forwards) setpoint.theta += M_PI;
+        const lemlib::Pose pose = getPose(true);
+
+        // once the trajectory is over, hold its end until the exit conditions are met
+        if (t >= trajectory.getDuration()) {
+            const float error = std::hypot(setpoint.x - pose.x, setpoint.y - pose.y);
+            lateralSmallExit.update(error);
+            lateralLargeExit.update(error);
+            if (lateralSmallExit.getExit() || lateralLargeExit.getExit()) break;
+        }
+
+        // error in the robot frame: forwards, to the left, and counter-clockwise
+        const float dx = setpoint.x - pose.x, dy = setpoint.y - pose.y;
+        const float errorForward = dx * std::sin(pose.theta) + dy * std::cos(pose.theta);
+        const float errorLeft = -dx * std::cos(pose.theta) + dy * std::sin(pose.theta);
+        const float errorTheta = std::remainder(pose.theta - setpoint.theta, 2 * M_PI);
+
+        // RAMSETE: the setpoint velocities plus feedback that converges for any heading error
+        const float v = direction * setpoint.velocity;
+        const float w = -setpoint.angularVelocity; // counter-clockwise
+        const float k = 2 * params.zeta * std::sqrt(w * w + params.b * v * v);
+        const float velocity = v * std::cos(errorTheta) + k * errorForward;
+        const float angular = w + k * errorTheta + params.b * v * sinc(errorTheta) * errorLeft;
+
+        const float halfTrack = drivetrain.trackWidth / 2;
+        const float acceleration = direction * setpoint.acceleration;
+        driveVelocity(velocity - angular * halfTrack, velocity + angular * halfTrack, acceleration, acceleration);
+
+        waitCycle();
+    }
+
+    // stop the drivetrain
+    driveVoltage(0, 0);
+    // set distTraveled to -1 to indicate that the function has finished
+    distTraveled = -1;
+    endMotion();
+}
+
+} // namespace motion
@@ -0,0 +1,45 @@
+#include "motion/gainSchedule.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace motion {
+
+GainSchedule::GainSchedule(std::vector<float> errors, std::vector<float> speeds, std::vector<PIDGains> gains)
+    : errors(std::move(errors)),
+      speeds(std::move(speeds)),
+      gains(std::move(gains)) {
+    // a table that does not match its axes is ignored rather than read out of bounds
+    if (this->errors.empty() || this->speeds.empty() ||
+        this->gains.size() != this->errors.size() * this->speeds.size()) {
+        this->gains.clear();
+    }
+}
+
+GainSchedule::GainSchedule(std::vector<float> errors, std::vector<PIDGains> gains)
+    : GainSchedule(std::move(errors), {0}, std::move(gains)) {}
+
+// index of the entry at or below a value and how far it is toward the next one
+static std::pair<std::size_t, float> locate(const std::vector<float>& axis, float value) {
+    if (axis.size() == 1 || value <= axis.front()) return {0, 0};
+    if (value >= axis.back()) return {axis.size() - 2, 1};
+    const std::size_t i = std::upper_bound(axis.begin(), axis.end(), value) - axis.begin() - 1;
+    const float span = axis[i + 1] - axis[i];
+    return {i, span > 0 ? (value - axis[i]) / span : 0};
+}
+
+static PIDGains blend(const PIDGains& a, const PIDGains& b, float t) {
+    return {a.kP + (b.kP - a.kP) * t, a.kI + (b.kI - a.kI) * t, a.kD + (b.kD - a.kD) * t};
+}
+
+PIDGains GainSchedule::lookup(float error, float speed) const {
+    if (gains.empty()) return {};
+    const auto [row, rowT] = locate(errors, std::fabs(error));
+    const auto [column, columnT] = locate(speeds, std::fabs(speed));
+    const std::size_t nextRow = std::min(row + 1, errors.size() - 1);
+    const std::size_t nextColumn = std::min(column + 1, speeds.size() - 1);
+    auto at = [&](std::size_t r, std::size_t c) { return gains[r * speeds.size() + c]; };
+    return blend(blend(at(row, column), at(row, nextColumn), columnT),
+                 blend(at(nextRow, column), at(nextRow, nextColumn), columnT), rowT);
+}
+
+} // namespace motion
@@ -0,0 +1,71 @@
+#include "motion/chassis.hpp"
+#include <algorithm>
+#include <cmath>
+#include "lemlib/logger/logger.hpp"
+#include "pros/rtos.hpp"
+
+namespace motion {
+
+void Chassis::setMarkers(std::vector<Marker> markers) {
+    std::lock_guard<pros::Mutex> lock(markerMutex);
+    pendingMarkers = std::move(markers);
+}
+
+void Chassis::beginMarkers() {
+    {
+        std::lock_guard<pros::Mutex> lock(markerMutex);
+        activeMarkers = std::move(pendingMarkers);
+        pendingMarkers.clear();
+    }
+    sortMarkers();
+    lastDistance = distTraveled;
+    lastMarkerTime = pros::micros();
+}
+
+void Chassis::discardMarkers(const char* motion) {
+    std::size_t count;
+    {
+        std::lock_guard<pros::Mutex> lock(markerMutex);
+        count = pendingMarkers.size();
+        pendingMarkers.clear();
+    }
+    if (count) lemlib::infoSink()->warn("{} does not fire markers, dropping {} of them", motion, count);
+}
+
+void Chassis::sortMarkers() {
+    std::stable_sort(activeMarkers.begin(), activeMarkers.end(),
+                     [](const Marker& a, const Marker& b) { return a.distance < b.distance; });
+    nextMarker = 0;
+}
+
+void Chassis::fireMarker() {
+    const Marker& marker = activeMarkers[nextMarker++];
+    lemlib::infoSink()->debug("marker {} at {:.2f}", marker.name, distTraveled);
+    if (marker.action) marker.action();
+}
+
+void Chassis::waitCycle() {
+    // markers the motion has already passed
+    while (nextMarker < activeMarkers.size() && activeMarkers[nextMarker].distance <= distTraveled) fireMarker();
+
+    // rate of travel since the last cycle predicts when the next marker is crossed
+    const std::uint64_t now = pros::micros();
+    const float elapsed = (now - lastMarkerTime) / 1e6f;
+    const float rate = elapsed > 0 ? (distTraveled - lastDistance) / elapsed : 0;
+    lastDistance = distTraveled;
+    lastMarkerTime = now;
+
+    // a marker crossed before the next cycle fires at its predicted time instead of up to a cycle late
+    std::uint32_t remaining = 10;
+    while (nextMarker < activeMarkers.size() && rate > 0) {
+        const float eta = (activeMarkers[nextMarker].distance - distTraveled) / rate * 1000;
+        if (eta >= remaining) break;
+        const std::uint32_t wait = std::max(0.0f, std::floor(eta));
+        pros::delay(wait);
+        remaining -= wait;
+        fireMarker();
+    }
+    pros::delay(remaining);
+}
+
+} // namespace motion
@@ -0,0 +1,180 @@
+#include "motion/chassis.hpp"
+#include <algorithm>
+#include <cmath>
+#include <optional>
+#include "lemlib/logger/logger.hpp"
+#include "lemlib/timer.hpp"
+#include "lemlib/util.hpp"
+#include "pros/rtos.hpp"
+
+namespace motion {
+
+// a planned leg of a chain: a straight line with its profile
+struct ChainLeg {
+        float startX, startY;
+        float dirX, dirY; // unit vector from the start to the target
+        float length; // to the target
+        float handoff; // distance along the line where the next leg takes over
+        bool forwards;
+        MotionProfile profile;
+};
+
+// a heuristic speed limit for the corner between two legs. the next leg is a straight line from the
+// handoff point and the heading PID does the turn, so the path actually driven depends on its gains.
+// the limit sizes the corner as an arc tangent to both lines exitRange before the corner, capped by the
+// outer wheel: faster with a longer exit range, and zero (a stop) at a right angle or sharper
+static float cornerVelocity(float trackWidth, float maxWheelVelocity, float exitRange, float turn) {
+    const float halfTurn = std::fabs(turn) / 2;
+    if (halfTurn < 1e-3) return maxWheelVelocity;
+    // turn is within +-pi, so compare the full angle: a right angle or sharper stops
+    if (std::fabs(turn) >= M_PI / 2 - 1e-3 || exitRange <= 0) return 0;
+    const float radius = exitRange / std::tan(halfTurn);
+    return maxWheelVelocity / (1 + trackWidth / (2 * radius));
+}
+
+void Chassis::moveChain(const std::vector<ChainStep>& steps, int timeout, ProfileShape profile, bool async) {
+    if (steps.empty()) {
+        lemlib::infoSink()->error("Motion chain is empty! Skipping motion");
+        discardMarkers("A skipped motion");
+        return;
+    }
+    requestMotionStart();
+    // were all motions cancelled?
+    if (!motionRunning) {
+        discardMarkers("A cancelled motion");
+        return;
+    }
+    // if the function is async, run it in a new task
+    if (async) {
+        pros::Task task([this, steps, timeout, profile] { moveChain(steps, timeout, profile, false); });
+        endMotion();
+        pros::delay(10); // delay to give the task time to start
+        return;
+    }
+
+    // plan leg i, starting where leg i - 1 hands off (or at the robot) at the velocity it hands off with
+    auto plan = [&](std::size_t i, float startX, float startY, float startVelocity) {
+        const ChainStep& step = steps[i];
+        const float dx = step.x - startX, dy = step.y - startY;
+        const float length = std::hypot(dx, dy);
+        const float dirX = length > 0 ? dx / length : 0, dirY = length > 0 ? dy / length : 0;
+        float handoff = length, endVelocity = 0;
+        if (i + 1 < steps.size()) {
+            const ChainStep& next = steps[i + 1];
+            handoff = std::max(0.0f, length - step.exitRange);
+            const float handoffX = startX + dirX * handoff, handoffY = startY + dirY * handoff;
+            // corner angle between this leg and the line from its handoff point to the next target
+            const float turn = std::remainder(std::atan2(next.x - handoffX, next.y - handoffY) - std::atan2(dx, dy),
+                                              2 * M_PI);
+            if (next.forwards == step.forwards) {
+                endVelocity = std::min(cornerVelocity(drivetrain.trackWidth, maxWheelVelocity(), step.exitRange, turn),
+                                       maxWheelVelocity() * std::clamp(next.maxSpeed, 0.0f, 127.0f) / 127);
+            }
+            // a leg that stops (a reversal or a sharp corner) stops on its target, not exitRange short of it
+            if (endVelocity <= 0) handoff = length;
+        }
+        return ChainLeg {startX, startY, dirX, dirY, length, handoff, step.forwards,
+                         linearProfile(handoff, profile, 0, 0, 0, step.maxSpeed, endVelocity, startVelocity)};
+    };
+
+    lateralFeedback.reset();
+    headingFeedback.reset();
+    lateralLargeExit.reset();
+    lateralSmallExit.reset();
+    distTraveled = 0;
+    beginMarkers();
+
+    // length of the legs after each step's target
+    std::vector<float> laterLegs(steps.size(), 0);
+    for (std::size_t i = steps.size() - 1; i-- > 0;) {
+        laterLegs[i] = laterLegs[i + 1] + std::hypot(steps[i + 1].x - steps[i].x, steps[i + 1].y - steps[i].y);
+    }
+
+    const lemlib::Pose start = getPose();
+    std::size_t current = 0;
+    // pick up from the robot's current speed if it is already moving the first leg's way
+    const WheelVelocities wheels = getWheelVelocities();
+    const float startVelocity = std::max(0.0f, (steps[0].forwards ? 1 : -1) * (wheels.left + wheels.right) / 2);
+    ChainLeg leg = plan(0, start.x, start.y, startVelocity);
+    std::optional<ChainLeg> next;
+    float previousLegs = 0; // distance covered by the finished legs
+    lemlib::Timer timer(timeout);
+    std::uint32_t legStart = pros::millis();
+    bool close = false;
+    while (!timer.isDone() && motionRunning) {
+        const lemlib::Pose pose = getPose();
+        const float t = (pros::millis() - legStart) / 1000.0f;
+        const ProfileState setpoint = leg.profile.sample(t);
+        const ChainStep& step = steps[current];
+        const bool last = current + 1 == steps.size();
+
+        // progress along the planned line
+        const float progress = (pose.x - leg.startX) * leg.dirX + (pose.y - leg.startY) * leg.dirY;
+        const float remaining = leg.length - progress;
+        distTraveled = previousLegs + progress;
+
+        // a leg that stops on its target (the last one, or one before a reversal or a sharp corner) ends
+        // once the profile is done and the robot has settled there
+        bool settled = false;
+        if (leg.handoff >= leg.length && t >= leg.profile.getDuration()) {
+            lateralSmallExit.update(std::fabs(remaining));
+            lateralLargeExit.update(std::fabs(remaining));
+            settled = lateralSmallExit.getExit() || lateralLargeExit.getExit();
+            if (last && settled) break;
+        }
+        if (!last && (progress >= leg.handoff || settled)) {
+            // hand off to the next leg at speed. it was planned during this one, so the switch costs a cycle
+            // at most instead of a stop and a new motion
+            if (!next) next = plan(current + 1, leg.startX + leg.dirX * leg.handoff,
+                                   leg.startY + leg.dirY * leg.handoff, leg.profile.sample(INFINITY).velocity);
+            previousLegs += progress;
+            leg = *next;
+            next.reset();
+            current++;
+            legStart = pros::millis();
+            close = false;
+            lateralFeedback.reset();
+            lateralSmallExit.reset();
+            lateralLargeExit.reset();
+            continue;
+        }
+
+        // point at the target until close, where the heading to it becomes unstable
+        if (std::fabs(remaining) < 7.5) close = true;
+        const WheelVelocities measured = getWheelVelocities();
+        float angular = 0;
+        if (!close) {
+            float targetHeading = lemlib::radToDeg(std::atan2(step.x - pose.x, step.y - pose.y));
+            if (!leg.forwards) targetHeading += 180;
+            const float headingError = lemlib::angleError(targetHeading, pose.theta, false);
+            scheduleAngular(headingError, measured);
+            angular = pidToVolts(headingFeedback.update(headingError));
+        }
+
+        // feedforward on the planned velocity, lateral PID on the error from the planned position. the
+        // schedule sees the distance to the end of the chain, so corners do not look like short moves
+        const float direction = leg.forwards ? 1 : -1;
+        scheduleLateral(remaining + laterLegs[current], measured);
+        const float lateral = direction * pidToVolts(lateralFeedback.update(setpoint.position - progress));
+        const float velocity = direction * setpoint.velocity;
+        const float acceleration = direction * setpoint.acceleration;
+        driveVoltage(sideVoltage(feedforward.left, velocity, acceleration, measured.left) + lateral + angular,
+                     sideVoltage(feedforward.right, velocity, acceleration, measured.right) + lateral - angular);
+
+        // plan the next leg while this one runs, after the motors have their command for this cycle
+        if (!last && !next) {
+            next = plan(current + 1, leg.startX + leg.dirX * leg.handoff, leg.startY + leg.dirY * leg.handoff,
+                        leg.profile.sample(INFINITY).velocity);
+        }
+
+        waitCycle();
+    }
+
+    // stop the drivetrain
+    driveVoltage(0, 0);
+    // set distTraveled to -1 to indicate that the function has finished
+    distTraveled = -1;
+    endMotion();
+}
+
+} // namespace motion
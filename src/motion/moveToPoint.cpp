@@ -0,0 +1,106 @@
+#include "motion/chassis.hpp"
+#include <algorithm>
+#include <cmath>
+#include "lemlib/timer.hpp"
+#include "lemlib/util.hpp"
+#include "pros/rtos.hpp"
+
+namespace motion {
+
+void Chassis::moveToPoint(float x, float y, int timeout, MoveToPointParams params, bool async) {
+    if (params.profile == ProfileShape::NONE) {
+        discardMarkers("moveToPoint without a profile");
+        lemlib::Chassis::moveToPoint(
+            x, y, timeout, {params.forwards, params.maxSpeed, params.minSpeed, params.earlyExitRange}, async);
+        return;
+    }
+    params.earlyExitRange = std::fabs(params.earlyExitRange);
+    params.maxSpeed = std::clamp(params.maxSpeed, 0.0f, 127.0f);
+    requestMotionStart();
+    // were all motions cancelled?
+    if (!motionRunning) {
+        discardMarkers("A cancelled motion");
+        return;
+    }
+    // if the function is async, run it in a new task
+    if (async) {
+        pros::Task task([this, x, y, timeout, params] { moveToPoint(x, y, timeout, params, false); });
+        endMotion();
+        pros::delay(10); // delay to give the task time to start
+        return;
+    }
+
+    lateralFeedback.reset();
+    headingFeedback.reset();
+    lateralLargeExit.reset();
+    lateralSmallExit.reset();
+    distTraveled = 0;
+    beginMarkers();
+
+    // plan a straight line from where the robot is now
+    const lemlib::Pose start = getPose();
+    const float distance = std::hypot(x - start.x, y - start.y);
+    const float dirX = distance > 0 ? (x - start.x) / distance : 0;
+    const float dirY = distance > 0 ? (y - start.y) / distance : 0;
+    const float direction = params.forwards ? 1 : -1;
+    // a min speed carries velocity into the next motion instead of stopping, and a motion that starts
+    // while the robot is still moving that way picks up from its current speed
+    const float endVelocity = maxWheelVelocity() * std::clamp(params.minSpeed, 0.0f, params.maxSpeed) / 127;
+    const WheelVelocities wheels = getWheelVelocities();
+    const float startVelocity = std::max(0.0f, direction * (wheels.left + wheels.right) / 2);
+    const MotionProfile profile = linearProfile(distance, params.profile, params.maxVelocity, params.maxAcceleration,
+                                                params.maxJerk, params.maxSpeed, endVelocity, startVelocity);
+
+    lemlib::Timer timer(timeout);
+    const std::uint32_t startTime = pros::millis();
+    bool close = false;
+    while (!timer.isDone() && motionRunning) {
+        const lemlib::Pose pose = getPose();
+        const float t = (pros::millis() - startTime) / 1000.0f;
+        const ProfileState setpoint = profile.sample(t);
+
+        // progress along the planned line
+        const float progress = (pose.x - start.x) * dirX + (pose.y - start.y) * dirY;
+        const float remaining = distance - progress;
+        distTraveled = progress;
+
+        // exit conditions
+        if (params.earlyExitRange > 0 && std::fabs(remaining) < params.earlyExitRange) break;
+        if (t >= profile.getDuration()) {
+            if (params.minSpeed != 0 && remaining <= 0) break; // passed the target at speed
+            lateralSmallExit.update(std::fabs(remaining));
+            lateralLargeExit.update(std::fabs(remaining));
+            if (lateralSmallExit.getExit() || lateralLargeExit.getExit()) break;
+        }
+
+        // point at the target until close, where the heading to it becomes unstable
+        if (std::fabs(remaining) < 7.5) close = true;
+        const WheelVelocities measured = getWheelVelocities();
+        float angular = 0;
+        if (!close) {
+            float targetHeading = lemlib::radToDeg(std::atan2(x - pose.x, y - pose.y));
+            if (!params.forwards) targetHeading += 180;
+            const float headingError = lemlib::angleError(targetHeading, pose.theta, false);
+            scheduleAngular(headingError, measured);
+            angular = pidToVolts(headingFeedback.update(headingError));
+        }
+
+        // feedforward on the planned velocity, lateral PID on the error from the planned position
+        scheduleLateral(remaining, measured);
+        const float lateral = direction * pidToVolts(lateralFeedback.update(setpoint.position - progress));
+        const float velocity = direction * setpoint.velocity;
+        const float acceleration = direction * setpoint.acceleration;
+        driveVoltage(sideVoltage(feedforward.left, velocity, acceleration, measured.left) + lateral + angular,
+                     sideVoltage(feedforward.right, velocity, acceleration, measured.right) + lateral - angular);
+
+        waitCycle();
+    }
+
+    // stop the drivetrain, unless handing off to the next motion at speed
+    if (params.minSpeed == 0) driveVoltage(0, 0);
+    // set distTraveled to -1 to indicate that the function has finished
+    distTraveled = -1;
+    endMotion();
+}
+
+} // namespace motion
@@ -0,0 +1,212 @@
+#include "motion/chassis.hpp"
+#include <algorithm>
+#include <cmath>
+#include "lemlib/chassis/odom.hpp"
+#include "lemlib/logger/logger.hpp"
+#include "lemlib/util.hpp"
+#include "pros/error.h"
+#include "runtime/loopTimer.hpp"
+
+namespace motion {
+
+void Chassis::setOdomBackend(OdomBackend backend, OdomNoise noise, pros::Gps* gps) {
+    odomBackend = backend;
+    odomNoise = noise;
+    this->gps = gps;
+}
+
+void Chassis::calibrate(bool calibrateIMU) {
+    if (odomBackend == OdomBackend::LEMLIB) {
+        lemlib::Chassis::calibrate(calibrateIMU);
+        return;
+    }
+    // the same IMU calibration as lemlib, without starting its odometry task
+    if (sensors.imu != nullptr && calibrateIMU) {
+        bool calibrated = false;
+        for (int attempt = 1; attempt <= 5 && !calibrated; attempt++) {
+            sensors.imu->reset();
+            do pros::delay(10);
+            while (sensors.imu->get_status() != pros::ImuStatus::error && sensors.imu->is_calibrating());
+            calibrated = std::isfinite(sensors.imu->get_heading());
+            if (!calibrated) lemlib::infoSink()->warn("IMU failed to calibrate! Attempt #{}", attempt);
+        }
+        if (!calibrated) {
+            sensors.imu = nullptr;
+            lemlib::infoSink()->error("IMU calibration failed, odometry is on the wheels alone");
+        }
+    }
+    for (lemlib::TrackingWheel* wheel : {sensors.vertical1, sensors.vertical2, sensors.horizontal1,
+                                         sensors.horizontal2}) {
+        if (wheel != nullptr) wheel->reset();
+    }
+
+    std::lock_guard<pros::Mutex> lock(odomMutex);
+    lastPublished = lemlib::getPose(true);
+    poseFilter.reset(lastPublished.x, lastPublished.y, lastPublished.theta);
+    lastWheels = getWheelPositions();
+    for (float& distance : lastTracking) distance = 0;
+    lastImu = sensors.imu != nullptr ? lemlib::degToRad(sensors.imu->get_rotation()) : 0;
+    imuMissed = !std::isfinite(lastImu);
+    if (imuMissed) lastImu = 0;
+    imuOffset = lastPublished.theta - lastImu;
+    lastOdomUpdate = pros::millis();
+    if (!odomTask) {
+        odomTask = std::make_unique<pros::Task>(
+            [this] {
+                runtime::LoopTimer loop(10);
+                loop.start();
+                while (true) {
+                    updateOdometry();
+                    loop.wait();
+                }
+            },
+            TASK_PRIORITY_DEFAULT + 1, TASK_STACK_DEPTH_DEFAULT, "ekf odometry");
+    }
+}
+
+PoseCovariance Chassis::getPoseCovariance() {
+    if (odomBackend == OdomBackend::LEMLIB) return {};
+    std::lock_guard<pros::Mutex> lock(odomMutex);
+    return poseFilter.getCovariance();
+}
+
+lemlib::Pose Chassis::getVelocity() {
+    if (odomBackend == OdomBackend::LEMLIB) return lemlib::getSpeed();
+    std::lock_guard<pros::Mutex> lock(odomMutex);
+    return odomVelocity;
+}
+
+// travel of a tracking wheel since the last update, and its standard deviation
+static float trackingDelta(lemlib::TrackingWheel* wheel, float& last, float fraction, float minimum,
+                           float& deviation) {
+    const float distance = wheel->getDistanceTraveled();
+    const float delta = distance - last;
+    last = distance;
+    deviation = fraction * std::fabs(delta) + minimum;
+    return delta;
+}
+
+void Chassis::updateOdometry() {
+    std::lock_guard<pros::Mutex> lock(odomMutex);
+    const std::uint32_t now = pros::millis();
+    const float dt = std::max<std::uint32_t>(1, now - lastOdomUpdate) / 1000.0f;
+    lastOdomUpdate = now;
+
+    // a pose that is not the one published last time was set by setPose: start over from it
+    const lemlib::Pose current = lemlib::getPose(true);
+    if (current.x != lastPublished.x || current.y != lastPublished.y || current.theta != lastPublished.theta) {
+        poseFilter.reset(current.x, current.y, current.theta);
+        imuOffset = current.theta - lastImu;
+    }
+
+    const OdomNoise& noise = odomNoise;
+    const float minimum = noise.minimumTravel;
+    const WheelPositions wheels = getWheelPositions();
+    const float left = wheels.left - lastWheels.left, right = wheels.right - lastWheels.right;
+    lastWheels = wheels;
+    const float trackWidth = drivetrain.trackWidth;
+
+    // the IMU turning at a different rate from the drive wheels means they are slipping, so trust them less
+    // a disconnected IMU reads PROS_ERR_F (infinite): go on the wheels alone until it is back, keeping the
+    // last good rotation. the first reading after a dropout covers several updates, so it says nothing of slip
+    float imuTurn = 0, slip = 1;
+    bool imuReading = false;
+    if (sensors.imu != nullptr) {
+        const float imu = lemlib::degToRad(sensors.imu->get_rotation());
+        imuReading = std::isfinite(imu);
+        if (imuReading) {
+            imuTurn = imu - lastImu;
+            lastImu = imu;
+            if (!imuMissed) {
+                const float disagreement = lemlib::radToDeg(std::fabs(imuTurn - (left - right) / trackWidth)) / dt;
+                slip = 1 + disagreement / noise.slipRate;
+            }
+        }
+        imuMissed = !imuReading;
+    }
+    const float leftDeviation = noise.wheelSlip * slip * std::fabs(left) + minimum;
+    const float rightDeviation = noise.wheelSlip * slip * std::fabs(right) + minimum;
+    const float leftVariance = leftDeviation * leftDeviation, rightVariance = rightDeviation * rightDeviation;
+
+    OdometryStep step = {};
+    // turn from two vertical tracking wheels if there are, otherwise from the drive sides
+    float deviations[4] = {};
+    float deltas[4] = {};
+    lemlib::TrackingWheel* tracking[4] = {sensors.vertical1, sensors.vertical2, sensors.horizontal1,
+                                          sensors.horizontal2};
+    for (int i = 0; i < 4; i++) {
+        if (tracking[i] != nullptr) {
+            deltas[i] = trackingDelta(tracking[i], lastTracking[i], noise.trackingWheel, minimum, deviations[i]);
+        }
+    }
+    const bool trackingTurn = tracking[0] != nullptr && tracking[1] != nullptr &&
+                              tracking[1]->getOffset() != tracking[0]->getOffset();
+    if (trackingTurn) {
+        const float spacing = tracking[1]->getOffset() - tracking[0]->getOffset();
+        step.turn = (deltas[0] - deltas[1]) / spacing;
+        step.turnVariance = (deviations[0] * deviations[0] + deviations[1] * deviations[1]) / (spacing * spacing);
+    } else {
+        step.turn = (left - right) / trackWidth;
+        step.turnVariance = (leftVariance + rightVariance) / (trackWidth * trackWidth);
+    }
+
+    // forward and sideways travel of the center, each wheel corrected for its offset as lemlib does
+    auto average = [&](int first, int last, float& value, float& variance) {
+        int count = 0;
+        value = variance = 0;
+        for (int i = first; i <= last; i++) {
+            if (tracking[i] == nullptr) continue;
+            value += deltas[i] + tracking[i]->getOffset() * step.turn;
+            variance += deviations[i] * deviations[i];
+            count++;
+        }
+        if (count == 0) return false;
+        value /= count;
+        variance /= count * count;
+        return true;
+    };
+    // the drive sides always give forward travel. with vertical tracking wheels as well, the two are fused by
+    // inverse variance, so slip shifts the weight onto the tracking wheels
+    step.forward = (left + right) / 2;
+    step.forwardVariance = (leftVariance + rightVariance) / 4;
+    if (!trackingTurn) step.forwardTurnCovariance = (leftVariance - rightVariance) / (2 * trackWidth);
+    float trackingForward, trackingVariance;
+    if (average(0, 1, trackingForward, trackingVariance)) {
+        const float driveWeight = trackingVariance / (trackingVariance + step.forwardVariance);
+        step.forward = driveWeight * step.forward + (1 - driveWeight) * trackingForward;
+        step.forwardVariance = driveWeight * step.forwardVariance;
+        step.forwardTurnCovariance *= driveWeight;
+    }
+    if (!average(2, 3, step.lateral, step.lateralVariance)) {
+        const float lateralDeviation = noise.lateralSlip * std::fabs(step.forward) + minimum;
+        step.lateral = 0;
+        step.lateralVariance = lateralDeviation * lateralDeviation;
+    }
+
+    const lemlib::Pose previous = {poseFilter.getX(), poseFilter.getY(), poseFilter.getTheta()};
+    poseFilter.predict(step);
+    if (imuReading) {
+        const float deviation = lemlib::degToRad(noise.imuHeading);
+        poseFilter.updateHeading(lastImu + imuOffset, deviation * deviation);
+    }
+    if (gps != nullptr) {
+        // only new readings, since the GPS updates slower than this loop
+        const pros::gps_position_s_t position = gps->get_position();
+        const double error = gps->get_error();
+        if (std::isfinite(position.x) && std::isfinite(position.y) && std::isfinite(error) &&
+            error != PROS_ERR_F && (position.x != lastGpsX || position.y != lastGpsY)) {
+            lastGpsX = position.x;
+            lastGpsY = position.y;
+            const float deviation = std::max<float>(error * 39.37, noise.gpsMinimum);
+            poseFilter.updatePosition(position.x * 39.37, position.y * 39.37, deviation * deviation,
+                                      noise.gpsGate);
+        }
+    }
+
+    lastPublished = {poseFilter.getX(), poseFilter.getY(), poseFilter.getTheta()};
+    lemlib::setPose(lastPublished, true);
+    odomVelocity = {(lastPublished.x - previous.x) / dt, (lastPublished.y - previous.y) / dt,
+                    lemlib::radToDeg(lastPublished.theta - previous.theta) / dt};
+}
+
+} // namespace motion
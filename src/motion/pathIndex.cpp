@@ -0,0 +1,43 @@
+#include "motion/pathIndex.hpp"
+
+namespace motion {
+
+float circleIntersect(const PathPoint& a, const PathPoint& b, float x, float y, float radius) {
+    const float dx = b.x - a.x, dy = b.y - a.y;
+    const float fx = a.x - x, fy = a.y - y;
+    const float qa = dx * dx + dy * dy;
+    const float qb = 2 * (fx * dx + fy * dy);
+    const float qc = fx * fx + fy * fy - radius * radius;
+    const float discriminant = qb * qb - 4 * qa * qc;
+    if (qa == 0 || discriminant < 0) return -1;
+    const float root = std::sqrt(discriminant);
+    // prefer the intersection further along the segment
+    const float t2 = (-qb + root) / (2 * qa);
+    if (t2 >= 0 && t2 <= 1) return t2;
+    const float t1 = (-qb - root) / (2 * qa);
+    if (t1 >= 0 && t1 <= 1) return t1;
+    return -1;
+}
+
+PathIndex::CellRange PathIndex::cellRange(float minX, float minY, float maxX, float maxY) const {
+    auto toCell = [this](float value, float origin, int cells) {
+        return std::clamp(int(std::floor((value - origin) / cellSize)), 0, cells - 1);
+    };
+    return {toCell(minX, originX, columns), toCell(minY, originY, rows), toCell(maxX, originX, columns),
+            toCell(maxY, originY, rows)};
+}
+
+void PathIndex::project(const PathPoint& a, const PathPoint& b, float x, float y, std::size_t segment,
+                        PathProjection& best) {
+    const float dx = b.x - a.x, dy = b.y - a.y;
+    const float lengthSquared = dx * dx + dy * dy;
+    const float along = lengthSquared > 0 ? ((x - a.x) * dx + (y - a.y) * dy) / lengthSquared : 0;
+    const float t = std::clamp(along, 0.0f, 1.0f);
+    const float distance = std::hypot(a.x + t * dx - x, a.y + t * dy - y);
+    // ties (shared end points, segments listed in several cells) go to the earlier segment
+    if (distance < best.distance || (distance == best.distance && segment < best.segment)) {
+        best = {segment, t, distance};
+    }
+}
+
+} // namespace motion
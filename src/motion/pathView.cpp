@@ -0,0 +1,59 @@
+#include "motion/pathView.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace motion {
+
+static std::int16_t toFixed(float value, float scale) {
+    return std::clamp<float>(std::round(value * scale), INT16_MIN, INT16_MAX);
+}
+
+PackedPathPoint packPathPoint(const PathPoint& point) {
+    return {toFixed(point.x, PATH_POSITION_SCALE), toFixed(point.y, PATH_POSITION_SCALE),
+            static_cast<std::uint16_t>(std::clamp<float>(std::round(point.velocity * PATH_VELOCITY_SCALE), 0,
+                                                         UINT16_MAX)),
+            toFixed(point.curvature, PATH_CURVATURE_SCALE)};
+}
+
+PathPoint unpackPathPoint(const PackedPathPoint& packed) {
+    return {packed.x / PATH_POSITION_SCALE, packed.y / PATH_POSITION_SCALE, packed.velocity / PATH_VELOCITY_SCALE,
+            packed.curvature / PATH_CURVATURE_SCALE};
+}
+
+std::uint32_t pathChecksum(const std::uint8_t* data, std::size_t size) {
+    std::uint32_t hash = 2166136261u;
+    for (std::size_t i = 0; i < size; i++) hash = (hash ^ data[i]) * 16777619u;
+    return hash;
+}
+
+PathView::PathView(const std::uint8_t* data, std::size_t size) {
+    if (data == nullptr || size < sizeof(PathHeader)) return;
+    std::memcpy(&header, data, sizeof(PathHeader));
+    if (header.magic != PATH_MAGIC || header.version != PATH_VERSION ||
+        header.pointSize != sizeof(PackedPathPoint) ||
+        size < sizeof(PathHeader) + std::size_t(header.count) * sizeof(PackedPathPoint))
+        return;
+    points = data + sizeof(PathHeader);
+    count = header.count;
+    valid = true;
+}
+
+bool PathView::isBinaryPath(const asset& path) {
+    std::uint32_t magic = 0;
+    if (path.size < sizeof(magic)) return false;
+    std::memcpy(&magic, path.buf, sizeof(magic));
+    return magic == PATH_MAGIC;
+}
+
+bool PathView::verify() const {
+    return valid && pathChecksum(points, count * sizeof(PackedPathPoint)) == header.checksum;
+}
+
+PathPoint PathView::operator[](std::size_t index) const {
+    PackedPathPoint packed;
+    std::memcpy(&packed, points + index * sizeof(PackedPathPoint), sizeof(PackedPathPoint));
+    return unpackPathPoint(packed);
+}
+
+} // namespace motion
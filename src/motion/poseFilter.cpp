@@ -0,0 +1,98 @@
+#include "motion/poseFilter.hpp"
+#include <cmath>
+
+namespace motion {
+
+using Matrix = std::array<float, 9>;
+
+static Matrix multiply(const Matrix& a, const Matrix& b) {
+    Matrix result = {};
+    for (int r = 0; r < 3; r++) {
+        for (int c = 0; c < 3; c++) {
+            for (int k = 0; k < 3; k++) result[r * 3 + c] += a[r * 3 + k] * b[k * 3 + c];
+        }
+    }
+    return result;
+}
+
+static Matrix transpose(const Matrix& a) {
+    return {a[0], a[3], a[6], a[1], a[4], a[7], a[2], a[5], a[8]};
+}
+
+// a * b * a^T
+static Matrix transform(const Matrix& a, const Matrix& b) { return multiply(multiply(a, b), transpose(a)); }
+
+void PoseFilter::reset(float x, float y, float theta, float positionVariance, float headingVariance) {
+    this->x = x;
+    this->y = y;
+    this->theta = theta;
+    covariance = {positionVariance, 0, 0, 0, positionVariance, 0, 0, 0, headingVariance};
+}
+
+void PoseFilter::predict(const OdometryStep& step) {
+    const float mean = theta + step.turn / 2;
+    const float s = std::sin(mean), c = std::cos(mean);
+    // travel in the field frame, and its rate of change with the heading
+    const float dx = step.forward * s - step.lateral * c;
+    const float dy = step.forward * c + step.lateral * s;
+    const float dxdTheta = step.forward * c + step.lateral * s;
+    const float dydTheta = -step.forward * s + step.lateral * c;
+    x += dx;
+    y += dy;
+    theta += step.turn;
+
+    // P = F P F^T + G Q G^T, F with respect to the pose and G to the step
+    const Matrix f = {1, 0, dxdTheta, 0, 1, dydTheta, 0, 0, 1};
+    const Matrix g = {s, -c, dxdTheta / 2, c, s, dydTheta / 2, 0, 0, 1};
+    const Matrix q = {step.forwardVariance, 0, step.forwardTurnCovariance, 0, step.lateralVariance, 0,
+                      step.forwardTurnCovariance, 0, step.turnVariance};
+    const Matrix propagated = transform(f, covariance);
+    const Matrix noise = transform(g, q);
+    for (int i = 0; i < 9; i++) covariance[i] = propagated[i] + noise[i];
+}
+
+void PoseFilter::updateHeading(float measured, float variance) {
+    // H = [0 0 1]: the gain is the heading column of P over the innovation variance
+    const float innovation = measured - theta;
+    const float s = covariance[8] + variance;
+    if (s <= 0) return;
+    const float gain[3] = {covariance[2] / s, covariance[5] / s, covariance[8] / s};
+    x += gain[0] * innovation;
+    y += gain[1] * innovation;
+    theta += gain[2] * innovation;
+    // P = (I - K H) P: subtract K times the heading row
+    const float row[3] = {covariance[6], covariance[7], covariance[8]};
+    for (int r = 0; r < 3; r++) {
+        for (int c = 0; c < 3; c++) covariance[r * 3 + c] -= gain[r] * row[c];
+    }
+}
+
+bool PoseFilter::updatePosition(float measuredX, float measuredY, float variance, float gate) {
+    // H = [I 0]: S is the position block of P plus the measurement noise
+    const float ex = measuredX - x, ey = measuredY - y;
+    const float sxx = covariance[0] + variance, sxy = covariance[1], syy = covariance[4] + variance;
+    const float determinant = sxx * syy - sxy * sxy;
+    if (determinant <= 0) return false;
+    const float ixx = syy / determinant, ixy = -sxy / determinant, iyy = sxx / determinant;
+    // reject outliers by their Mahalanobis distance
+    if (ex * (ixx * ex + ixy * ey) + ey * (ixy * ex + iyy * ey) > gate * gate) return false;
+
+    // K = P H^T S^-1, from the first two columns of P
+    float gain[3][2];
+    for (int r = 0; r < 3; r++) {
+        gain[r][0] = covariance[r * 3] * ixx + covariance[r * 3 + 1] * ixy;
+        gain[r][1] = covariance[r * 3] * ixy + covariance[r * 3 + 1] * iyy;
+    }
+    x += gain[0][0] * ex + gain[0][1] * ey;
+    y += gain[1][0] * ex + gain[1][1] * ey;
+    theta += gain[2][0] * ex + gain[2][1] * ey;
+    const Matrix before = covariance;
+    for (int r = 0; r < 3; r++) {
+        for (int c = 0; c < 3; c++) {
+            covariance[r * 3 + c] -= gain[r][0] * before[c] + gain[r][1] * before[3 + c];
+        }
+    }
+    return true;
+}
+
+} // namespace motion
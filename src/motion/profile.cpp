@@ -0,0 +1,111 @@
+#include "motion/profile.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace motion {
+
+MotionProfile::MotionProfile(float startVelocity) { end.velocity = startVelocity; }
+
+ProfileState MotionProfile::integrate(const ProfileState& initial, float jerk, float t) {
+    ProfileState state;
+    state.acceleration = initial.acceleration + jerk * t;
+    state.velocity = initial.velocity + initial.acceleration * t + jerk * t * t / 2;
+    state.position =
+        initial.position + initial.velocity * t + initial.acceleration * t * t / 2 + jerk * t * t * t / 6;
+    return state;
+}
+
+void MotionProfile::add(float duration, float acceleration, float jerk) {
+    if (duration <= 0 || segmentCount == segments.size()) return;
+    ProfileState initial = end;
+    initial.acceleration = acceleration;
+    segments[segmentCount++] = {this->duration, duration, jerk, initial};
+    this->duration += duration;
+    end = integrate(initial, jerk, duration);
+    end.acceleration = 0;
+}
+
+MotionProfile MotionProfile::trapezoidal(float distance, float maxVelocity, float maxAcceleration,
+                                         float startVelocity, float endVelocity) {
+    const float d = std::fabs(distance);
+    const float a = maxAcceleration;
+    float v0 = std::min(std::fabs(startVelocity), maxVelocity);
+    // the end velocity can only be as high as accelerating the whole way allows
+    float vf = std::min({std::fabs(endVelocity), maxVelocity, std::sqrt(v0 * v0 + 2 * a * d)});
+    MotionProfile profile(v0);
+    if (d == 0 || a <= 0 || maxVelocity <= 0) return profile;
+
+    if (v0 * v0 - vf * vf > 2 * a * d) {
+        // too fast to slow down in time: brake the whole way and end above the requested velocity
+        float t = (v0 - std::sqrt(v0 * v0 - 2 * a * d)) / a;
+        profile.add(t, -a, 0);
+        return profile;
+    }
+
+    // peak velocity where the acceleration and deceleration ramps meet
+    const float peak = std::min(maxVelocity, std::sqrt((2 * a * d + v0 * v0 + vf * vf) / 2));
+    const float accelDistance = (peak * peak - v0 * v0) / (2 * a);
+    const float decelDistance = (peak * peak - vf * vf) / (2 * a);
+    profile.add((peak - v0) / a, a, 0);
+    profile.add((d - accelDistance - decelDistance) / peak, 0, 0);
+    profile.add((peak - vf) / a, -a, 0);
+    return profile;
+}
+
+// time with max jerk, time at max acceleration, and distance covered while accelerating from rest to v
+static void sCurveRamp(float v, float a, float j, float& jerkTime, float& accelTime, float& distance) {
+    if (v * j < a * a) {
+        // never reaches max acceleration
+        jerkTime = std::sqrt(v / j);
+        accelTime = 0;
+    } else {
+        jerkTime = a / j;
+        accelTime = v / a - jerkTime;
+    }
+    // the ramp is symmetric about its midpoint, so the average velocity is v / 2
+    distance = v * (2 * jerkTime + accelTime) / 2;
+}
+
+MotionProfile MotionProfile::sCurve(float distance, float maxVelocity, float maxAcceleration, float maxJerk) {
+    if (maxJerk <= 0) return trapezoidal(distance, maxVelocity, maxAcceleration);
+    const float d = std::fabs(distance);
+    const float a = maxAcceleration;
+    const float j = maxJerk;
+    MotionProfile profile(0);
+    if (d == 0 || a <= 0 || maxVelocity <= 0) return profile;
+
+    float jerkTime, accelTime, rampDistance;
+    float peak = maxVelocity;
+    sCurveRamp(peak, a, j, jerkTime, accelTime, rampDistance);
+    if (2 * rampDistance > d) {
+        // no cruise: find the peak velocity whose two ramps exactly cover the distance
+        float low = 0, high = maxVelocity;
+        for (int i = 0; i < 40; i++) {
+            peak = (low + high) / 2;
+            sCurveRamp(peak, a, j, jerkTime, accelTime, rampDistance);
+            if (2 * rampDistance > d) high = peak;
+            else low = peak;
+        }
+        peak = low;
+        sCurveRamp(peak, a, j, jerkTime, accelTime, rampDistance);
+    }
+    const float rampAccel = j * jerkTime;
+    profile.add(jerkTime, 0, j);
+    profile.add(accelTime, rampAccel, 0);
+    profile.add(jerkTime, rampAccel, -j);
+    profile.add((d - 2 * rampDistance) / peak, 0, 0);
+    profile.add(jerkTime, 0, -j);
+    profile.add(accelTime, -rampAccel, 0);
+    profile.add(jerkTime, -rampAccel, j);
+    return profile;
+}
+
+ProfileState MotionProfile::sample(float t) const {
+    if (segmentCount == 0 || t >= duration) return end;
+    if (t <= 0) return integrate(segments[0].initial, segments[0].jerk, 0);
+    std::size_t i = 0;
+    while (i + 1 < segmentCount && t >= segments[i + 1].start) i++;
+    return integrate(segments[i].initial, segments[i].jerk, t - segments[i].start);
+}
+
+} // namespace motion
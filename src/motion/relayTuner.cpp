@@ -0,0 +1,213 @@
+#include "motion/relayTuner.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace motion {
+
+PlantModel::PlantModel(float gain, float delay, float lag, float deadband, float dt)
+    : gain(gain),
+      lag(lag),
+      deadband(deadband),
+      dt(dt),
+      pending(std::max<std::size_t>(1, std::lround(delay / dt) + 1), 0) {}
+
+float PlantModel::update(float output) {
+    output = std::clamp(output, -127.0f, 127.0f);
+    // the output applied now reaches the plant after the dead time
+    pending[head] = output;
+    head = (head + 1) % pending.size();
+    float applied = pending[head];
+    if (std::fabs(applied) < deadband) applied = 0;
+    const float target = gain * applied;
+    velocity += lag > 0 ? (target - velocity) * std::min(1.0f, dt / lag) : target - velocity;
+    position += velocity * dt;
+    return position;
+}
+
+void PlantModel::reset() {
+    std::fill(pending.begin(), pending.end(), 0);
+    head = 0;
+    velocity = 0;
+    position = 0;
+}
+
+RelayTuner::RelayTuner(float amplitude, float hysteresis, int cycles, float rampRate)
+    : amplitude(std::fabs(amplitude)),
+      hysteresis(std::fabs(hysteresis)),
+      cycles(std::max(1, cycles)),
+      rampRate(std::fabs(rampRate)) {}
+
+float RelayTuner::update(float t, float error) {
+    if (done()) return 0;
+    if (rampStart < 0) {
+        rampStart = t;
+        startError = error;
+        rampDirection = error < 0 ? -1 : 1;
+    }
+    if (ramping && std::fabs(error - startError) <= hysteresis) {
+        // ramp until the plant moves. the output it took is an upper bound on the deadband
+        output = rampDirection * std::min(rampRate * (t - rampStart), amplitude);
+    } else if (ramping) {
+        // moving: switch against the error to start the oscillation
+        ramping = false;
+        output = error < 0 ? -amplitude : amplitude;
+        if (output > 0) lastRise = t;
+        minError = maxError = error;
+    } else {
+        minError = std::min(minError, error);
+        maxError = std::max(maxError, error);
+        if (output < 0 && error > hysteresis) {
+            output = amplitude;
+            // a rising switch closes a cycle. the first one starts from rest and is not representative
+            if (lastRise >= 0 && settled) {
+                periodSum += t - lastRise;
+                peakSum += (maxError - minError) / 2;
+                completed++;
+            }
+            if (lastRise >= 0 && !settled) {
+                settled = true;
+                cyclesStart = trace.size();
+            }
+            lastRise = t;
+            minError = maxError = error;
+        } else if (output > 0 && error < -hysteresis) {
+            output = -amplitude;
+        }
+    }
+    trace.push_back({output, error});
+    return output;
+}
+
+float RelayTuner::getUltimatePeriod() const { return completed ? periodSum / completed : 0; }
+
+float RelayTuner::getOscillation() const { return completed ? peakSum / completed : 0; }
+
+float RelayTuner::getUltimateGain() const {
+    const float a = getOscillation();
+    return a > 0 ? 4 * amplitude / (M_PI * a) : 0;
+}
+
+// fit over the measured cycles for one dead time (in updates) and lag: the least squares gain and velocity
+// at the start of the window, and the squared error left. position from there is gain * x + velocity * g,
+// where x is the response to the recorded outputs at unit gain and g the decay of the starting velocity
+static double fitWindow(const std::vector<RelaySample>& trace, std::size_t from, std::size_t delay, float lag,
+                        float dt, float& gain, float& velocity) {
+    const float blend = lag > 0 ? std::min(1.0f, dt / lag) : 1;
+    double xx = 0, xg = 0, gg = 0, xy = 0, gy = 0, yy = 0;
+    float v = 0, x = 0, decay = 1, g = 0;
+    for (std::size_t i = from; i + 1 < trace.size(); i++) {
+        const float applied = i >= delay ? trace[i - delay].output : 0;
+        v += (applied - v) * blend;
+        x += v * dt;
+        decay *= 1 - blend;
+        g += decay * dt;
+        const float y = trace[from].error - trace[i + 1].error;
+        xx += x * x, xg += x * g, gg += g * g, xy += x * y, gy += g * y, yy += y * y;
+    }
+    const double det = xx * gg - xg * xg;
+    if (gg <= 0 || det <= 1e-9 * xx * gg) {
+        // no lag, so nothing of the starting velocity is left after a step
+        gain = xx > 0 ? xy / xx : 0, velocity = 0;
+    } else {
+        gain = (xy * gg - gy * xg) / det, velocity = (gy * xx - xy * xg) / det;
+    }
+    // residual of the fit: sum of (y - gain x - velocity g)^2, expanded
+    return yy - 2 * (gain * xy + velocity * gy) + gain * gain * xx + 2 * gain * velocity * xg +
+           velocity * velocity * gg;
+}
+
+void identifyPlant(const RelayTuner& relay, TuneResult& result) {
+    const std::vector<RelaySample>& trace = relay.getTrace();
+    const float dt = 0.01;
+    const std::size_t from = relay.getCyclesStart();
+    if (trace.size() < from + 2 || result.ultimatePeriod <= 0) return;
+
+    // an integrator with dead time alone oscillates at 4 dead times, and lag only shortens that, so the
+    // dead time is under a quarter period. the lag is searched up to a whole one
+    const std::size_t maxDelay = std::size_t(result.ultimatePeriod / 4 / dt) + 1;
+    const std::size_t maxLag = std::size_t(result.ultimatePeriod / dt) + 1;
+    double best = INFINITY;
+    for (std::size_t delay = 0; delay <= maxDelay; delay++) {
+        for (std::size_t lag = 0; lag <= maxLag; lag++) {
+            float gain, velocity;
+            const double residual = fitWindow(trace, from, delay, lag * dt, dt, gain, velocity);
+            if (gain > 0 && residual < best) {
+                best = residual;
+                result.plantGain = gain;
+                result.plantDelay = delay * dt;
+                result.plantLag = lag * dt;
+            }
+        }
+    }
+
+    // the relay's outputs clear the deadband, so only the ramp shows it: replay the experiment up to the
+    // measured cycles for each deadband up to the output that first moved the plant
+    float rampPeak = 0;
+    for (std::size_t i = 0; i < from; i++) rampPeak = std::max(rampPeak, std::fabs(trace[i].output));
+    best = INFINITY;
+    for (float deadband = 0; deadband <= rampPeak; deadband += 0.25) {
+        PlantModel plant(result.plantGain, result.plantDelay, result.plantLag, deadband, dt);
+        double residual = 0;
+        for (std::size_t i = 0; i < from; i++) {
+            const float error = trace[0].error - plant.update(trace[i].output) - trace[i + 1].error;
+            residual += error * error;
+        }
+        // ties go to the larger deadband, as the ramp only resolves it to one update's step
+        if (residual <= best) best = residual, result.plantDeadband = deadband;
+    }
+}
+
+TuneResult proposeGains(const RelayTuner& relay, TuningRule rule, float step, float settleError,
+                        float settleTimeout) {
+    TuneResult result {};
+    result.ultimateGain = relay.getUltimateGain();
+    result.ultimatePeriod = relay.getUltimatePeriod();
+    if (result.ultimateGain <= 0 || result.ultimatePeriod <= 0) {
+        result.settleTime = -1;
+        return result;
+    }
+    identifyPlant(relay, result);
+
+    float kP = 0, derivativeTime = 0;
+    switch (rule) {
+        case TuningRule::CLASSIC:
+            kP = 0.6 * result.ultimateGain, derivativeTime = result.ultimatePeriod / 8;
+            break;
+        case TuningRule::SOME_OVERSHOOT:
+            kP = 0.33 * result.ultimateGain, derivativeTime = result.ultimatePeriod / 3;
+            break;
+        case TuningRule::NO_OVERSHOOT:
+            kP = 0.2 * result.ultimateGain, derivativeTime = result.ultimatePeriod / 3;
+            break;
+    }
+    // lemlib's derivative is the change per 10 ms update
+    result.gains = {kP, 0, kP * derivativeTime / 0.01f};
+    result.settleTime = simulateSettle(
+        PlantModel(result.plantGain, result.plantDelay, result.plantLag, result.plantDeadband), result.gains, step,
+        settleError, settleTimeout);
+    return result;
+}
+
+float simulateSettle(PlantModel plant, PIDGains gains, float step, float settleError, float settleTimeout,
+                     float maxTime) {
+    plant.reset();
+    const float dt = 0.01;
+    float integral = 0, previousError = step;
+    float settledSince = -1;
+    for (float t = 0; t < maxTime; t += dt) {
+        const float error = step - plant.getPosition();
+        if (std::fabs(error) < settleError) {
+            if (settledSince < 0) settledSince = t;
+            if (t - settledSince >= settleTimeout) return settledSince;
+        } else {
+            settledSince = -1;
+        }
+        integral += error;
+        const float output = gains.kP * error + gains.kI * integral + gains.kD * (error - previousError);
+        previousError = error;
+        plant.update(output);
+    }
+    return -1;
+}
+
+} // namespace motion
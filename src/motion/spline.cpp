@@ -0,0 +1,87 @@
+#include "motion/spline.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace motion {
+
+SplinePath::SplinePath(const std::vector<Waypoint>& waypoints) {
+    for (std::size_t i = 0; i + 1 < waypoints.size(); i++) {
+        const Waypoint& a = waypoints[i];
+        const Waypoint& b = waypoints[i + 1];
+        const float chord = std::hypot(b.x - a.x, b.y - a.y);
+        const float startTangent = a.tangent > 0 ? a.tangent : chord;
+        const float endTangent = b.tangent > 0 ? b.tangent : chord;
+        const float startHeading = a.heading * M_PI / 180;
+        const float endHeading = b.heading * M_PI / 180;
+        // a Hermite segment is a Bezier with the inner control points a third of each tangent in
+        addSegment({a.x, a.y},
+                   {a.x + startTangent / 3 * std::sin(startHeading), a.y + startTangent / 3 * std::cos(startHeading)},
+                   {b.x - endTangent / 3 * std::sin(endHeading), b.y - endTangent / 3 * std::cos(endHeading)},
+                   {b.x, b.y});
+    }
+}
+
+SplinePath SplinePath::bezier(const std::vector<ControlPoint>& controlPoints) {
+    SplinePath path;
+    for (std::size_t i = 0; i + 3 < controlPoints.size(); i += 3) {
+        path.addSegment(controlPoints[i], controlPoints[i + 1], controlPoints[i + 2], controlPoints[i + 3]);
+    }
+    return path;
+}
+
+PathPoint SplinePath::evaluate(const Segment& segment, float t) {
+    const auto& [p0, p1, p2, p3] = segment.control;
+    const float u = 1 - t;
+    // position, first and second derivatives of the cubic Bezier
+    const float x = u * u * u * p0.x + 3 * u * u * t * p1.x + 3 * u * t * t * p2.x + t * t * t * p3.x;
+    const float y = u * u * u * p0.y + 3 * u * u * t * p1.y + 3 * u * t * t * p2.y + t * t * t * p3.y;
+    const float dx = 3 * u * u * (p1.x - p0.x) + 6 * u * t * (p2.x - p1.x) + 3 * t * t * (p3.x - p2.x);
+    const float dy = 3 * u * u * (p1.y - p0.y) + 6 * u * t * (p2.y - p1.y) + 3 * t * t * (p3.y - p2.y);
+    const float ddx = 6 * u * (p2.x - 2 * p1.x + p0.x) + 6 * t * (p3.x - 2 * p2.x + p1.x);
+    const float ddy = 6 * u * (p2.y - 2 * p1.y + p0.y) + 6 * t * (p3.y - 2 * p2.y + p1.y);
+    const float speed = std::hypot(dx, dy);
+    const float curvature = speed > 0 ? (dx * ddy - dy * ddx) / (speed * speed * speed) : 0;
+    return {x, y, 0, curvature};
+}
+
+void SplinePath::addSegment(ControlPoint p0, ControlPoint p1, ControlPoint p2, ControlPoint p3) {
+    Segment segment = {{p0, p1, p2, p3}, length, 0, {}};
+    // arc length by summing chords between evenly spaced parameters
+    PathPoint previous = evaluate(segment, 0);
+    for (std::size_t i = 1; i <= TABLE_SIZE; i++) {
+        const PathPoint point = evaluate(segment, float(i) / TABLE_SIZE);
+        segment.table[i] = segment.table[i - 1] + std::hypot(point.x - previous.x, point.y - previous.y);
+        previous = point;
+    }
+    segment.length = segment.table[TABLE_SIZE];
+    length += segment.length;
+    segments.push_back(segment);
+}
+
+PathPoint SplinePath::sample(float distance) const {
+    if (segments.empty()) return {0, 0};
+    distance = std::clamp(distance, 0.0f, length);
+    // last segment starting at or before the distance
+    auto it = std::upper_bound(segments.begin(), segments.end(), distance,
+                               [](float d, const Segment& segment) { return d < segment.start; });
+    const Segment& segment = *(it == segments.begin() ? it : it - 1);
+    const float local = std::min(distance - segment.start, segment.length);
+    // invert the arc length table, interpolating linearly between entries
+    const auto entry = std::lower_bound(segment.table.begin() + 1, segment.table.end() - 1, local);
+    const std::size_t i = entry - segment.table.begin();
+    const float span = segment.table[i] - segment.table[i - 1];
+    const float fraction = span > 0 ? (local - segment.table[i - 1]) / span : 0;
+    return evaluate(segment, (i - 1 + std::clamp(fraction, 0.0f, 1.0f)) / TABLE_SIZE);
+}
+
+std::vector<PathPoint> SplinePath::discretize(float spacing) const {
+    std::vector<PathPoint> points;
+    if (segments.empty() || spacing <= 0) return points;
+    const std::size_t count = std::ceil(length / spacing);
+    points.reserve(count + 1);
+    for (std::size_t i = 0; i < count; i++) points.push_back(sample(i * spacing));
+    points.push_back(sample(length));
+    return points;
+}
+
+} // namespace motion
@@ -0,0 +1,164 @@
+#include "motion/sysid.hpp"
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+namespace motion {
+
+static const char* const TEST_NAMES[] = {"qf", "qb", "df", "db", "sc", "sa"};
+
+const char* sysIdTestName(SysIdTest test) { return TEST_NAMES[int(test)]; }
+
+std::string formatSysIdConfig(const SysIdConfig& config) {
+    char line[128];
+    std::snprintf(line, sizeof(line), "sysid,config,%.4f,%.4f,%g,%g,%g", config.trackWidth, config.wheelDiameter,
+                  config.rpm, config.horizontalDrift, config.velocityKP);
+    return line;
+}
+
+std::string formatSysIdSample(SysIdTest test, const SysIdSample& sample) {
+    char line[160];
+    std::snprintf(line, sizeof(line), "sysid,%s,%.4f,%.3f,%.3f,%.3f,%.3f,%.2f,%.2f,%.3f", sysIdTestName(test),
+                  sample.time, sample.leftVoltage, sample.rightVoltage, sample.leftPosition, sample.rightPosition,
+                  sample.leftVelocity, sample.rightVelocity, sample.heading);
+    return line;
+}
+
+bool SysIdLog::parseLine(const std::string& line) {
+    // the terminal may prefix lines, so look for the tag anywhere
+    const std::size_t start = line.find("sysid,");
+    if (start == std::string::npos) return false;
+    const char* fields = line.c_str() + start + 6;
+    if (std::strncmp(fields, "config,", 7) == 0) {
+        SysIdConfig parsed;
+        if (std::sscanf(fields + 7, "%f,%f,%f,%f,%f", &parsed.trackWidth, &parsed.wheelDiameter, &parsed.rpm,
+                        &parsed.horizontalDrift, &parsed.velocityKP) != 5) {
+            return false;
+        }
+        config = parsed;
+        hasConfig = true;
+        return true;
+    }
+    for (int test = 0; test < 6; test++) {
+        const std::size_t length = std::strlen(TEST_NAMES[test]);
+        if (std::strncmp(fields, TEST_NAMES[test], length) != 0 || fields[length] != ',') continue;
+        SysIdSample sample;
+        if (std::sscanf(fields + length + 1, "%f,%f,%f,%f,%f,%f,%f,%f", &sample.time, &sample.leftVoltage,
+                        &sample.rightVoltage, &sample.leftPosition, &sample.rightPosition, &sample.leftVelocity,
+                        &sample.rightVelocity, &sample.heading) != 8) {
+            return false;
+        }
+        tests[test].push_back(sample);
+        return true;
+    }
+    return false;
+}
+
+// solve a 3x3 system by Gaussian elimination with partial pivoting. false if it is singular
+static bool solve3(double a[3][3], double b[3], double x[3]) {
+    for (int column = 0; column < 3; column++) {
+        int pivot = column;
+        for (int row = column + 1; row < 3; row++) {
+            if (std::fabs(a[row][column]) > std::fabs(a[pivot][column])) pivot = row;
+        }
+        if (std::fabs(a[pivot][column]) < 1e-12) return false;
+        std::swap(a[pivot], a[column]);
+        std::swap(b[pivot], b[column]);
+        for (int row = column + 1; row < 3; row++) {
+            const double factor = a[row][column] / a[column][column];
+            for (int k = column; k < 3; k++) a[row][k] -= factor * a[column][k];
+            b[row] -= factor * b[column];
+        }
+    }
+    for (int row = 2; row >= 0; row--) {
+        double sum = b[row];
+        for (int k = row + 1; k < 3; k++) sum -= a[row][k] * x[k];
+        x[row] = sum / a[row][row];
+    }
+    return true;
+}
+
+FeedforwardFit fitFeedforward(const SysIdLog& log, bool left, float minVelocity) {
+    // over a block of time dt at a steady voltage the model gives v' = alpha v + beta V + gamma sgn(v), with
+    // alpha = e^(-kV dt / kA), beta = (1 - alpha) / kV and gamma = -beta kS. fitting that from block to block
+    // needs no acceleration, which differentiating the positions twice would bury in encoder noise
+    constexpr std::size_t BLOCK = 5;
+    double ata[3][3] = {}, atb[3] = {};
+    double sumV = 0, sumV2 = 0, sumDt = 0;
+    std::size_t count = 0;
+    std::vector<double> rows; // sgn, velocity, voltage, next velocity
+    for (SysIdTest test : {SysIdTest::QUASISTATIC_FORWARD, SysIdTest::QUASISTATIC_BACKWARD,
+                           SysIdTest::DYNAMIC_FORWARD, SysIdTest::DYNAMIC_BACKWARD}) {
+        const std::vector<SysIdSample>& samples = log[test];
+        auto position = [&](std::size_t i) { return left ? samples[i].leftPosition : samples[i].rightPosition; };
+        auto voltage = [&](std::size_t i) { return left ? samples[i].leftVoltage : samples[i].rightVoltage; };
+        for (std::size_t i = 0; i + 2 * BLOCK < samples.size(); i++) {
+            const double dt = samples[i + BLOCK].time - samples[i].time;
+            const double nextDt = samples[i + 2 * BLOCK].time - samples[i + BLOCK].time;
+            if (dt <= 0 || nextDt <= 0) continue;
+            const double v = (position(i + BLOCK) - position(i)) / dt;
+            const double next = (position(i + 2 * BLOCK) - position(i + BLOCK)) / nextDt;
+            // mean voltage across both blocks, since the quasistatic ramp keeps changing it
+            double mean = 0;
+            bool stopped = false;
+            for (std::size_t j = i; j < i + 2 * BLOCK; j++) {
+                mean += voltage(j);
+                stopped |= voltage(j) == 0;
+            }
+            mean /= 2 * BLOCK;
+            if (stopped || std::fabs(v) < minVelocity) continue;
+            const double x[3] = {v, mean, v > 0 ? 1.0 : -1.0};
+            for (int r = 0; r < 3; r++) {
+                for (int c = 0; c < 3; c++) ata[r][c] += x[r] * x[c];
+                atb[r] += x[r] * next;
+            }
+            rows.insert(rows.end(), {x[0], x[1], x[2], next});
+            sumV += next;
+            sumV2 += next * next;
+            sumDt += (dt + nextDt) / 2;
+            count++;
+        }
+    }
+
+    double k[3] = {};
+    if (count < 3 || !solve3(ata, atb, k)) return {{}, 0, count};
+    const double alpha = k[0], beta = k[1], gamma = k[2];
+    if (alpha <= 0 || alpha >= 1 || beta <= 0) return {{}, 0, count}; // not a plant that settles
+    double residual = 0;
+    for (std::size_t i = 0; i < rows.size(); i += 4) {
+        const double error = rows[i + 3] - (alpha * rows[i] + beta * rows[i + 1] + gamma * rows[i + 2]);
+        residual += error * error;
+    }
+    const double variance = sumV2 - sumV * sumV / count;
+    const double kV = (1 - alpha) / beta;
+    const double kA = -kV * (sumDt / count) / std::log(alpha);
+    return {{float(-gamma / beta), float(kV), float(kA)}, variance > 0 ? float(1 - residual / variance) : 0, count};
+}
+
+float fitTrackWidth(const SysIdLog& log) {
+    // least squares through the origin of (left - right) wheel travel against the heading change in radians
+    double sumXY = 0, sumXX = 0;
+    for (SysIdTest test : {SysIdTest::SPIN_CLOCKWISE, SysIdTest::SPIN_COUNTERCLOCKWISE}) {
+        const std::vector<SysIdSample>& samples = log[test];
+        if (samples.empty()) continue;
+        const SysIdSample& first = samples.front();
+        for (const SysIdSample& sample : samples) {
+            const double turned = (sample.heading - first.heading) * M_PI / 180;
+            const double travel = (sample.leftPosition - first.leftPosition) -
+                                  (sample.rightPosition - first.rightPosition);
+            sumXY += turned * travel;
+            sumXX += turned * turned;
+        }
+    }
+    return sumXX > 0 ? float(sumXY / sumXX) : 0;
+}
+
+float testDistance(const SysIdLog& log, SysIdTest test) {
+    const std::vector<SysIdSample>& samples = log[test];
+    if (samples.empty()) return 0;
+    const SysIdSample& first = samples.front();
+    const SysIdSample& last = samples.back();
+    return ((last.leftPosition - first.leftPosition) + (last.rightPosition - first.rightPosition)) / 2;
+}
+
+} // namespace motion
@@ -0,0 +1,50 @@
+#include "motion/trajectory.hpp"
+#include <algorithm>
+
+namespace motion {
+
+void Trajectory::finish() {
+    if (states.size() < 2) {
+        states.clear();
+        return;
+    }
+    for (std::size_t i = 0; i < states.size(); i++) {
+        // heading along the path, from the neighbouring points
+        const TrajectoryState& before = states[i == 0 ? 0 : i - 1];
+        const TrajectoryState& after = states[std::min(i + 1, states.size() - 1)];
+        states[i].theta = std::atan2(after.x - before.x, after.y - before.y);
+        if (i == 0) continue;
+        // constant acceleration over each segment
+        TrajectoryState& previous = states[i - 1];
+        const float length = std::hypot(states[i].x - previous.x, states[i].y - previous.y);
+        const float speed = previous.velocity + states[i].velocity;
+        const float dt = speed > 0 ? 2 * length / speed : 0;
+        states[i].distance = previous.distance + length;
+        states[i].time = previous.time + dt;
+        previous.acceleration = dt > 0 ? (states[i].velocity - previous.velocity) / dt : 0;
+    }
+}
+
+TrajectoryState Trajectory::sample(float t) const {
+    if (states.empty()) return {};
+    if (t <= 0) return states.front();
+    if (t >= states.back().time) return states.back();
+    // first state after t, and the one before it
+    const auto it = std::upper_bound(states.begin(), states.end(), t,
+                                     [](float time, const TrajectoryState& state) { return time < state.time; });
+    const TrajectoryState& a = *(it - 1);
+    const TrajectoryState& b = *it;
+    const float dt = t - a.time;
+    TrajectoryState state = a;
+    state.time = t;
+    state.velocity = a.velocity + a.acceleration * dt;
+    state.distance = a.distance + (a.velocity + state.velocity) / 2 * dt;
+    const float fraction = b.distance > a.distance ? (state.distance - a.distance) / (b.distance - a.distance) : 0;
+    state.x = a.x + fraction * (b.x - a.x);
+    state.y = a.y + fraction * (b.y - a.y);
+    state.theta = a.theta + fraction * std::remainder(b.theta - a.theta, 2 * M_PI);
+    state.angularVelocity = a.angularVelocity + fraction * (b.angularVelocity - a.angularVelocity);
+    return state;
+}
+
+} // namespace motion
@@ -0,0 +1,92 @@
+#include "motion/chassis.hpp"
+#include <algorithm>
+#include <cmath>
+#include "lemlib/timer.hpp"
+#include "lemlib/util.hpp"
+#include "pros/rtos.hpp"
+
+namespace motion {
+
+void Chassis::turnToHeading(float theta, int timeout, TurnToHeadingParams params, bool async) {
+    if (params.profile == ProfileShape::NONE) {
+        discardMarkers("turnToHeading without a profile");
+        lemlib::Chassis::turnToHeading(
+            theta, timeout, {params.direction, params.maxSpeed, params.minSpeed, params.earlyExitRange}, async);
+        return;
+    }
+    params.earlyExitRange = std::fabs(params.earlyExitRange);
+    params.maxSpeed = std::clamp(params.maxSpeed, 0, 127);
+    requestMotionStart();
+    // were all motions cancelled?
+    if (!motionRunning) {
+        discardMarkers("A cancelled motion");
+        return;
+    }
+    // if the function is async, run it in a new task
+    if (async) {
+        pros::Task task([this, theta, timeout, params] { turnToHeading(theta, timeout, params, false); });
+        endMotion();
+        pros::delay(10); // delay to give the task time to start
+        return;
+    }
+
+    turnPID.reset();
+    angularLargeExit.reset();
+    angularSmallExit.reset();
+    distTraveled = 0;
+    beginMarkers();
+
+    // plan the turn as wheel travel, so the linear feedforward limits apply directly
+    float previousHeading = getPose().theta;
+    const float turn = lemlib::angleError(theta, previousHeading, false, params.direction);
+    const float sign = turn < 0 ? -1 : 1;
+    const float degreesPerInch = 360 / (M_PI * drivetrain.trackWidth);
+    const float endVelocity = maxWheelVelocity() * std::clamp(params.minSpeed, 0, params.maxSpeed) / 127;
+    const MotionProfile profile =
+        linearProfile(std::fabs(turn) / degreesPerInch, params.profile, params.maxVelocity / degreesPerInch,
+                      params.maxAcceleration / degreesPerInch, params.maxJerk / degreesPerInch, params.maxSpeed,
+                      endVelocity);
+
+    lemlib::Timer timer(timeout);
+    const std::uint32_t startTime = pros::millis();
+    float turned = 0; // degrees in the direction of the turn
+    while (!timer.isDone() && motionRunning) {
+        const float heading = getPose().theta;
+        // accumulate small steps so turns past 180 degrees are tracked correctly
+        turned += sign * lemlib::angleError(heading, previousHeading, false);
+        previousHeading = heading;
+        const float remaining = std::fabs(turn) - turned;
+        distTraveled = turned;
+
+        const float t = (pros::millis() - startTime) / 1000.0f;
+        const ProfileState setpoint = profile.sample(t);
+
+        // exit conditions
+        if (params.earlyExitRange > 0 && std::fabs(remaining) < params.earlyExitRange) break;
+        if (t >= profile.getDuration()) {
+            if (params.minSpeed != 0 && remaining <= 0) break; // passed the target at speed
+            angularSmallExit.update(std::fabs(remaining));
+            angularLargeExit.update(std::fabs(remaining));
+            if (angularSmallExit.getExit() || angularLargeExit.getExit()) break;
+        }
+
+        // feedforward on the planned wheel velocity, angular PID on the error from the planned heading
+        const WheelVelocities measured = getWheelVelocities();
+        scheduleAngular(remaining, measured);
+        const float feedback = sign * pidToVolts(turnPID.update(setpoint.position * degreesPerInch, turned));
+        const float velocity = sign * setpoint.velocity;
+        const float acceleration = sign * setpoint.acceleration;
+        driveVoltage(sideVoltage(feedforward.left, velocity, acceleration, measured.left) + feedback,
+                     sideVoltage(feedforward.right, -velocity, -acceleration, measured.right) - feedback);
+
+        waitCycle();
+    }
+
+    // stop the drivetrain, unless handing off to the next motion at speed
+    if (params.minSpeed == 0) driveVoltage(0, 0);
+    // set distTraveled to -1 to indicate that the function has finished
+    distTraveled = -1;
+    endMotion();
+}
+
+} // namespace motion
@@ -0,0 +1,84 @@
+#include "motion/velocityPlanner.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace motion {
+
+void computeCurvature(std::vector<PathPoint>& points) {
+    for (std::size_t i = 0; i < points.size(); i++) {
+        if (i == 0 || i + 1 == points.size()) {
+            points[i].curvature = 0;
+            continue;
+        }
+        const PathPoint& a = points[i - 1];
+        const PathPoint& b = points[i];
+        const PathPoint& c = points[i + 1];
+        // 1 / circumradius = 2 * cross / (product of the side lengths)
+        const float cross = (b.x - a.x) * (c.y - b.y) - (b.y - a.y) * (c.x - b.x);
+        const float sides = std::hypot(b.x - a.x, b.y - a.y) * std::hypot(c.x - b.x, c.y - b.y) *
+                            std::hypot(c.x - a.x, c.y - a.y);
+        points[i].curvature = sides > 0 ? 2 * cross / sides : 0;
+    }
+}
+
+// how much faster the outer wheel moves than the center
+static float outerWheelFactor(const DriveLimits& limits, float curvature) {
+    return 1 + std::fabs(curvature) * limits.trackWidth / 2;
+}
+
+// center acceleration (or braking) available at a point without either wheel exceeding its limit
+static float centerAcceleration(const DriveLimits& limits, const PathPoint& point, bool braking) {
+    const float factor = outerWheelFactor(limits, point.curvature);
+    const float wheelVelocity = point.velocity * factor;
+    float wheel = limits.maxWheelAcceleration;
+    if (braking) {
+        wheel = std::min({wheel, limits.left.maxDeceleration(wheelVelocity, limits.voltage),
+                          limits.right.maxDeceleration(wheelVelocity, limits.voltage)});
+    } else {
+        wheel = std::min({wheel, limits.left.maxAcceleration(wheelVelocity, limits.voltage),
+                          limits.right.maxAcceleration(wheelVelocity, limits.voltage)});
+    }
+    return std::max(wheel, 0.0f) / factor;
+}
+
+float planVelocities(std::vector<PathPoint>& points, const DriveLimits& limits, float startVelocity,
+                     float endVelocity) {
+    if (points.empty()) return 0;
+
+    // velocity cap at each point from wheel speed and lateral acceleration
+    for (PathPoint& point : points) {
+        point.velocity = limits.maxWheelVelocity / outerWheelFactor(limits, point.curvature);
+        if (limits.maxLateralAcceleration > 0 && point.curvature != 0) {
+            point.velocity =
+                std::min(point.velocity, std::sqrt(limits.maxLateralAcceleration / std::fabs(point.curvature)));
+        }
+    }
+    points.front().velocity = std::min(points.front().velocity, startVelocity);
+    points.back().velocity = std::min(points.back().velocity, endVelocity);
+
+    auto segmentLength = [&](std::size_t i) {
+        return std::hypot(points[i + 1].x - points[i].x, points[i + 1].y - points[i].y);
+    };
+
+    // forward pass: limit how fast each point can be reached from the one before it
+    for (std::size_t i = 0; i + 1 < points.size(); i++) {
+        const float a = centerAcceleration(limits, points[i], false);
+        const float reachable = std::sqrt(points[i].velocity * points[i].velocity + 2 * a * segmentLength(i));
+        points[i + 1].velocity = std::min(points[i + 1].velocity, reachable);
+    }
+    // backward pass: limit each point so the robot can still brake for the one after it
+    for (std::size_t i = points.size() - 1; i > 0; i--) {
+        const float d = centerAcceleration(limits, points[i], true);
+        const float stoppable = std::sqrt(points[i].velocity * points[i].velocity + 2 * d * segmentLength(i - 1));
+        points[i - 1].velocity = std::min(points[i - 1].velocity, stoppable);
+    }
+
+    float time = 0;
+    for (std::size_t i = 0; i + 1 < points.size(); i++) {
+        const float average = (points[i].velocity + points[i + 1].velocity) / 2;
+        if (average > 0) time += segmentLength(i) / average;
+    }
+    return time;
+}
+
+} // namespace motion
@@ -0,0 +1,65 @@
+#include "runtime/batteryCompensation.hpp"
+#include <algorithm>
+#include "pros/misc.hpp"
+#include "pros/rtos.hpp"
+
+namespace runtime {
+
+// readings below this are a brain without a battery (USB power) or a bad sample
+constexpr float MIN_BATTERY_VOLTAGE = 6;
+
+BatteryCompensation::BatteryCompensation(float nominalVoltage, float timeConstant)
+    : nominalVoltage(nominalVoltage),
+      timeConstant(timeConstant) {}
+
+float BatteryCompensation::getVoltage() {
+    const std::uint32_t now = pros::millis();
+    const std::uint32_t last = lastUpdate.load(std::memory_order_relaxed);
+    float filtered = voltage.load(std::memory_order_relaxed);
+    if (filtered != 0 && now - last < 10) return filtered;
+    lastUpdate.store(now, std::memory_order_relaxed);
+
+    const float measured = pros::battery::get_voltage() / 1000.0f;
+    if (measured < MIN_BATTERY_VOLTAGE) return filtered != 0 ? filtered : MOTOR_FULL_SCALE_VOLTAGE;
+    if (filtered == 0 || timeConstant <= 0) filtered = measured;
+    else filtered += (measured - filtered) * std::min(1.0f, (now - last) / 1000.0f / timeConstant);
+    voltage.store(filtered, std::memory_order_relaxed);
+    return filtered;
+}
+
+std::int32_t BatteryCompensation::toCommand(float volts) {
+    const float command = volts * MOTOR_FULL_SCALE_VOLTAGE / getVoltage() * 1000;
+    return std::clamp(command, -MOTOR_FULL_SCALE_VOLTAGE * 1000, MOTOR_FULL_SCALE_VOLTAGE * 1000);
+}
+
+std::int32_t BatteryCompensation::powerToCommand(std::int32_t power) {
+    return toCommand(std::clamp<std::int32_t>(power, -127, 127) * nominalVoltage / 127);
+}
+
+CompensatedMotorGroup::CompensatedMotorGroup(BatteryCompensation& battery, std::initializer_list<std::int8_t> ports,
+                                             pros::v5::MotorGears gearset, pros::v5::MotorUnits encoderUnits)
+    : pros::MotorGroup(ports, gearset, encoderUnits),
+      battery(battery) {}
+
+std::int32_t CompensatedMotorGroup::move(std::int32_t power) const {
+    return pros::MotorGroup::move_voltage(battery.powerToCommand(power));
+}
+
+std::int32_t CompensatedMotorGroup::move_voltage(std::int32_t voltage) const {
+    return pros::MotorGroup::move_voltage(battery.toCommand(voltage / 1000.0f));
+}
+
+CompensatedMotor::CompensatedMotor(BatteryCompensation& battery, std::int8_t port, pros::v5::MotorGears gearset,
+                                   pros::v5::MotorUnits encoderUnits)
+    : pros::Motor(port, gearset, encoderUnits),
+      battery(battery) {}
+
+std::int32_t CompensatedMotor::move(std::int32_t power) const {
+    return pros::Motor::move_voltage(battery.powerToCommand(power));
+}
+
+std::int32_t CompensatedMotor::move_voltage(std::int32_t voltage) const {
+    return pros::Motor::move_voltage(battery.toCommand(voltage / 1000.0f));
+}
+
+} // namespace runtime
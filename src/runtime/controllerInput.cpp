@@ -0,0 +1,77 @@
+#include "runtime/controllerInput.hpp"
+#include "pros/rtos.hpp"
+
+namespace runtime {
+
+static constexpr std::uint8_t buttonIndex(pros::controller_digital_e_t button) {
+    return button - pros::E_CONTROLLER_DIGITAL_L1;
+}
+
+bool ControllerFrame::isHeld(pros::controller_digital_e_t button) const {
+    return buttons & (1 << buttonIndex(button));
+}
+
+ControllerInput::ControllerInput(pros::Controller& controller, std::uint32_t holdTime, std::uint32_t doubleTapTime)
+    : controller(controller),
+      holdTime(holdTime),
+      doubleTapTime(doubleTapTime) {}
+
+void ControllerInput::bind(pros::controller_digital_e_t button, ButtonEvent event, std::function<void()> callback) {
+    watch(button);
+    bindings.push_back({buttonIndex(button), event, std::move(callback)});
+}
+
+void ControllerInput::watch(pros::controller_digital_e_t button) { buttonMask |= 1 << buttonIndex(button); }
+
+void ControllerInput::watch(pros::controller_analog_e_t axis) { analogMask |= 1 << axis; }
+
+const ControllerFrame& ControllerInput::update() {
+    const std::uint16_t previous = frame.buttons;
+    frame.time = pros::millis();
+    frame.buttons = 0;
+    for (std::uint8_t i = 0; i < pressTime.size(); i++) {
+        if (!(buttonMask & (1 << i))) continue;
+        auto button = static_cast<pros::controller_digital_e_t>(pros::E_CONTROLLER_DIGITAL_L1 + i);
+        if (controller.get_digital(button)) frame.buttons |= 1 << i;
+    }
+    for (std::uint8_t i = 0; i < frame.analog.size(); i++) {
+        if (analogMask & (1 << i))
+            frame.analog[i] = controller.get_analog(static_cast<pros::controller_analog_e_t>(i));
+    }
+    published.write(frame);
+
+    const std::uint16_t pressed = frame.buttons & ~previous;
+    const std::uint16_t released = previous & ~frame.buttons;
+    for (std::uint8_t i = 0; i < pressTime.size(); i++) {
+        const std::uint16_t bit = 1 << i;
+        if (!(buttonMask & bit)) continue;
+        if (pressed & bit) {
+            const bool doubleTap = (tapArmed & bit) && frame.time - pressTime[i] <= doubleTapTime;
+            pressTime[i] = frame.time;
+            holdFired &= ~bit;
+            dispatch(i, ButtonEvent::PRESS);
+            if (doubleTap) {
+                // a third tap starts a new pair instead of firing again
+                tapArmed &= ~bit;
+                dispatch(i, ButtonEvent::DOUBLE_TAP);
+            } else {
+                tapArmed |= bit;
+            }
+        } else if (released & bit) {
+            dispatch(i, ButtonEvent::RELEASE);
+        } else if ((frame.buttons & bit) && !(holdFired & bit) && frame.time - pressTime[i] >= holdTime) {
+            holdFired |= bit;
+            tapArmed &= ~bit; // a hold is not the first half of a double tap
+            dispatch(i, ButtonEvent::HOLD);
+        }
+    }
+    return frame;
+}
+
+void ControllerInput::dispatch(std::uint8_t index, ButtonEvent event) {
+    for (const Binding& binding : bindings) {
+        if (binding.index == index && binding.event == event) binding.callback();
+    }
+}
+
+} // namespace runtime
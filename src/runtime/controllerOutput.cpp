@@ -0,0 +1,98 @@
+#include "runtime/controllerOutput.hpp"
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+
+namespace runtime {
+
+ControllerOutput::ControllerOutput(pros::Controller& controller, std::uint32_t updateInterval)
+    : controller(controller),
+      updateInterval(updateInterval) {}
+
+void ControllerOutput::start() {
+    if (task) return;
+    task = std::make_unique<pros::Task>(
+        [this] {
+            std::uint32_t lastWake = pros::millis();
+            while (true) {
+                sendNext();
+                pros::Task::delay_until(&lastWake, updateInterval);
+            }
+        },
+        TASK_PRIORITY_DEFAULT - 2, TASK_STACK_DEPTH_DEFAULT, "controller output");
+}
+
+void ControllerOutput::print(std::uint8_t line, const char* fmt, ...) {
+    if (line >= CONTROLLER_LINES) return;
+    char text[CONTROLLER_LINE_LENGTH + 1];
+    va_list args;
+    va_start(args, fmt);
+    int length = vsnprintf(text, sizeof(text), fmt, args);
+    va_end(args);
+    if (length < 0) return;
+    // pad with spaces so the new text fully covers the old
+    for (std::size_t i = length; i < CONTROLLER_LINE_LENGTH; i++) text[i] = ' ';
+    text[CONTROLLER_LINE_LENGTH] = '\0';
+
+    std::lock_guard<pros::Mutex> lock(mutex);
+    if (std::strcmp(lines[line].data(), text) == 0) return;
+    if (dirty & (1 << line)) coalesced++;
+    std::memcpy(lines[line].data(), text, sizeof(text));
+    dirty |= 1 << line;
+}
+
+void ControllerOutput::clearLine(std::uint8_t line) { print(line, "%s", ""); }
+
+void ControllerOutput::rumble(const char* pattern, int priority) {
+    Rumble next = {{}, priority, 0};
+    std::strncpy(next.pattern.data(), pattern, next.pattern.size() - 1);
+
+    std::lock_guard<pros::Mutex> lock(mutex);
+    next.order = rumbleOrder++;
+    if (rumbleCount == rumbles.size()) {
+        // replace the lowest priority, newest pattern if the new one outranks it
+        std::size_t lowest = 0;
+        for (std::size_t i = 1; i < rumbleCount; i++) {
+            if (rumbles[i].priority < rumbles[lowest].priority ||
+                (rumbles[i].priority == rumbles[lowest].priority && rumbles[i].order > rumbles[lowest].order))
+                lowest = i;
+        }
+        if (rumbles[lowest].priority >= priority) return;
+        rumbles[lowest] = next;
+        return;
+    }
+    rumbles[rumbleCount++] = next;
+}
+
+void ControllerOutput::sendNext() {
+    std::array<char, CONTROLLER_LINE_LENGTH + 1> text;
+    std::array<char, 9> pattern;
+    int line = -1;
+    bool hasRumble = false;
+    {
+        std::lock_guard<pros::Mutex> lock(mutex);
+        if (rumbleCount > 0) {
+            std::size_t best = 0;
+            for (std::size_t i = 1; i < rumbleCount; i++) {
+                if (rumbles[i].priority > rumbles[best].priority ||
+                    (rumbles[i].priority == rumbles[best].priority && rumbles[i].order < rumbles[best].order))
+                    best = i;
+            }
+            pattern = rumbles[best].pattern;
+            rumbles[best] = rumbles[--rumbleCount];
+            hasRumble = true;
+        } else if (dirty) {
+            while (!(dirty & (1 << nextLine))) nextLine = (nextLine + 1) % CONTROLLER_LINES;
+            line = nextLine;
+            text = lines[line];
+            dirty &= ~(1 << line);
+            nextLine = (nextLine + 1) % CONTROLLER_LINES;
+        }
+    }
+    // talk to the controller outside the lock so callers never wait on it
+    if (hasRumble) controller.rumble(pattern.data());
+    else if (line >= 0) controller.set_text(line, 0, text.data());
+}
+
+} // namespace runtime
@@ -0,0 +1,47 @@
+#include "runtime/loopTimer.hpp"
+#include "pros/rtos.hpp"
+
+namespace runtime {
+
+LoopTimer::LoopTimer(std::uint32_t periodMs)
+    : periodMs(periodMs) {}
+
+void LoopTimer::start() {
+    lastWake = pros::millis();
+    lastWakeMicros = pros::micros();
+}
+
+void LoopTimer::wait() {
+    std::uint32_t work = pros::micros() - lastWakeMicros;
+    stats.lastWork = work;
+    if (work > stats.maxWork) stats.maxWork = work;
+
+    if (pros::millis() - lastWake > periodMs) {
+        // the body ran past its deadline. re-anchor instead of letting delay_until
+        // return immediately for every missed period and burst to catch up
+        stats.overruns++;
+        lastWake = pros::millis();
+    } else {
+        pros::Task::delay_until(&lastWake, periodMs);
+    }
+
+    std::uint64_t wake = pros::micros();
+    std::uint32_t period = wake - lastWakeMicros;
+    lastWakeMicros = wake;
+
+    stats.iterations++;
+    stats.lastPeriod = period;
+    stats.totalPeriod += period;
+    if (period < stats.minPeriod) stats.minPeriod = period;
+    if (period > stats.maxPeriod) stats.maxPeriod = period;
+
+    const std::uint32_t nominal = periodMs * 1000;
+    const std::uint32_t jitter = period > nominal ? period - nominal : nominal - period;
+    std::size_t bucket = 0;
+    while (bucket < JITTER_BUCKET_LIMITS.size() && jitter >= JITTER_BUCKET_LIMITS[bucket]) bucket++;
+    stats.jitter[bucket]++;
+}
+
+void LoopTimer::resetStats() { stats = LoopStats(); }
+
+} // namespace runtime
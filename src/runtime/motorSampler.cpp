@@ -0,0 +1,66 @@
+#include "runtime/motorSampler.hpp"
+#include <algorithm>
+
+namespace runtime {
+
+float MotorGroupSample::averageTemperature() const {
+    if (size == 0) return 0;
+    float sum = 0;
+    for (std::size_t i = 0; i < size; i++) sum += temperature[i];
+    return sum / size;
+}
+
+float MotorGroupSample::maxTemperature() const {
+    if (size == 0) return 0;
+    return *std::max_element(temperature.begin(), temperature.begin() + size);
+}
+
+std::uint32_t MotorGroupSample::combinedFaults() const {
+    std::uint32_t combined = 0;
+    for (std::size_t i = 0; i < size; i++) combined |= faults[i];
+    return combined;
+}
+
+MotorSampler::MotorSampler(std::initializer_list<pros::AbstractMotor*> groups, std::uint32_t periodMs)
+    : periodMs(periodMs) {
+    for (pros::AbstractMotor* group : groups) {
+        if (groupCount == MAX_SAMPLED_GROUPS) break;
+        this->groups[groupCount++] = group;
+    }
+}
+
+void MotorSampler::start() {
+    if (task) return;
+    task = std::make_unique<pros::Task>(
+        [this] {
+            std::uint32_t lastWake = pros::millis();
+            while (true) {
+                sample();
+                pros::Task::delay_until(&lastWake, periodMs);
+            }
+        },
+        TASK_PRIORITY_DEFAULT - 2, TASK_STACK_DEPTH_DEFAULT, "motor sampler");
+}
+
+// copy up to MAX_GROUP_MOTORS values from a get_*_all() result
+template <typename T, typename U>
+static std::uint8_t copyAll(const std::vector<T>& from, std::array<U, MAX_GROUP_MOTORS>& to) {
+    std::size_t count = std::min(from.size(), to.size());
+    std::copy_n(from.begin(), count, to.begin());
+    return count;
+}
+
+void MotorSampler::sample() {
+    MotorSnapshot next;
+    for (std::size_t i = 0; i < groupCount; i++) {
+        MotorGroupSample& out = next.groups[i];
+        out.size = copyAll(groups[i]->get_temperature_all(), out.temperature);
+        copyAll(groups[i]->get_current_draw_all(), out.current);
+        copyAll(groups[i]->get_actual_velocity_all(), out.velocity);
+        copyAll(groups[i]->get_faults_all(), out.faults);
+    }
+    next.time = pros::millis();
+    snapshot.write(next);
+}
+
+} // namespace runtime
@@ -0,0 +1,89 @@
+#include "runtime/profiler.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+namespace runtime {
+
+static std::size_t bucketOf(std::uint32_t micros) {
+    if (micros < 4) return micros;
+    const int msb = 31 - __builtin_clz(micros);
+    const std::size_t index = (msb - 1) * 4 + ((micros >> (msb - 2)) & 3);
+    return std::min(index, PROFILE_BUCKETS - 1);
+}
+
+static std::uint32_t bucketLowerBound(std::size_t index) {
+    if (index < 4) return index;
+    return (4 + index % 4) << (index / 4 - 1);
+}
+
+std::uint32_t SectionStats::percentile(float fraction) const {
+    if (count == 0) return 0;
+    const std::uint32_t target = std::ceil(fraction * count);
+    std::uint32_t seen = 0;
+    for (std::size_t i = 0; i < histogram.size(); i++) {
+        seen += histogram[i];
+        if (seen >= target) {
+            if (i + 1 == histogram.size()) return max;
+            return std::min(bucketLowerBound(i + 1) - 1, max);
+        }
+    }
+    return max;
+}
+
+std::size_t Profiler::addSection(const char* name, std::uint32_t budget) {
+    for (std::size_t i = 0; i < sectionCount; i++) {
+        if (std::strcmp(sections[i].name, name) == 0) return i;
+    }
+    if (sectionCount == sections.size()) return sections.size() - 1; // share the last section
+    sections[sectionCount].name = name;
+    sections[sectionCount].budget = budget;
+    return sectionCount++;
+}
+
+void Profiler::record(std::size_t section, std::uint32_t micros) {
+    SectionStats& stats = sections[section];
+    stats.count++;
+    stats.total += micros;
+    if (micros < stats.min) stats.min = micros;
+    if (micros > stats.max) stats.max = micros;
+    stats.histogram[bucketOf(micros)]++;
+    if (stats.budget != 0 && micros > stats.budget) {
+        stats.overruns++;
+        stats.lastOverrun = pros::millis();
+        overruns++;
+    }
+}
+
+void Profiler::reset() {
+    for (std::size_t i = 0; i < sectionCount; i++) {
+        SectionStats fresh;
+        fresh.name = sections[i].name;
+        fresh.budget = sections[i].budget;
+        sections[i] = fresh;
+    }
+    overruns = 0;
+}
+
+void Profiler::format(char* buffer, std::size_t size) const {
+    if (size == 0) return;
+    buffer[0] = '\0';
+    int used = std::snprintf(buffer, size, "%-10s %7s %7s %7s %7s %5s\n", "section", "min", "mean", "p99", "max",
+                             "over");
+    for (std::size_t i = 0; i < sectionCount && used >= 0 && std::size_t(used) < size; i++) {
+        const SectionStats& s = sections[i];
+        used += std::snprintf(buffer + used, size - used, "%-10s %7u %7.0f %7u %7u %5u\n", s.name,
+                              static_cast<unsigned>(s.count ? s.min : 0), s.mean(),
+                              static_cast<unsigned>(s.percentile(0.99)), static_cast<unsigned>(s.max),
+                              static_cast<unsigned>(s.overruns));
+    }
+}
+
+void Profiler::dump() const {
+    char table[128 * (MAX_PROFILE_SECTIONS + 1)];
+    format(table, sizeof(table));
+    std::printf("loop profile at %u ms (microseconds)\n%s", static_cast<unsigned>(pros::millis()), table);
+}
+
+} // namespace runtime
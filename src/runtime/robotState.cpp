@@ -0,0 +1,31 @@
+#include "runtime/robotState.hpp"
+#include <memory>
+#include "pros/rtos.hpp"
+#include "runtime/seqlock.hpp"
+
+namespace runtime {
+
+static Seqlock<RobotState> state;
+static std::unique_ptr<pros::Task> publisher;
+
+void startStatePublisher(motion::Chassis& chassis, std::uint32_t periodMs) {
+    if (publisher) return;
+    publisher = std::make_unique<pros::Task>(
+        [&chassis, periodMs] {
+            std::uint32_t lastWake = pros::millis();
+            while (true) {
+                RobotState next;
+                next.pose = chassis.getPose();
+                next.velocity = chassis.getVelocity();
+                next.covariance = chassis.getPoseCovariance();
+                next.time = pros::millis();
+                state.write(next);
+                pros::Task::delay_until(&lastWake, periodMs);
+            }
+        },
+        TASK_PRIORITY_DEFAULT + 1, TASK_STACK_DEPTH_DEFAULT, "state publisher");
+}
+
+RobotState getRobotState() { return state.read(); }
+
+} // namespace runtime
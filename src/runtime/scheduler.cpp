@@ -0,0 +1,42 @@
+#include "runtime/scheduler.hpp"
+
+namespace runtime {
+
+void Scheduler::addStage(const char* name, std::uint32_t periodMs, std::uint32_t priority,
+                         std::function<void()> fn) {
+    std::size_t section = profiler ? profiler->addSection(name, periodMs * 1000) : 0;
+    stages.push_back(std::make_unique<Stage>(name, periodMs, priority, std::move(fn), section));
+}
+
+void Scheduler::start() {
+    if (running.exchange(true)) return;
+    for (auto& stage : stages) {
+        Stage* s = stage.get();
+        s->task = std::make_unique<pros::Task>([this, s] { run(*s); }, s->priority, TASK_STACK_DEPTH_DEFAULT,
+                                               s->name);
+    }
+}
+
+void Scheduler::stop() {
+    if (!running.exchange(false)) return;
+    for (auto& stage : stages) {
+        if (stage->task) stage->task->join();
+        stage->task.reset();
+    }
+}
+
+void Scheduler::run(Stage& stage) {
+    stage.timer.resetStats();
+    stage.timer.start();
+    while (running) {
+        if (profiler) {
+            ScopedTimer timer(*profiler, stage.section);
+            stage.fn();
+        } else {
+            stage.fn();
+        }
+        stage.timer.wait();
+    }
+}
+
+} // namespace runtime
@@ -1,23 +1,28 @@
 #include "screen/gui.hpp"
 #include "globals.h"
 
-namespace screen {
+namespace gui {
 
 // Button map for LVGL GUI
 static const char *btnmMap[] = {"far side", "close side", "skills", ""};
 
+// Loop profiler table, refreshed by updateGUI()
+static lv_obj_t *profileLabel = nullptr;
+static std::uint32_t lastProfileRefresh = 0;
+static std::uint32_t lastProfileOverruns = 0;
+
 void autonBtnmAction(lv_event_t *e) {
     lv_obj_t *obj = lv_event_get_target(e);
     const char *txt = lv_btnmatrix_get_btn_text(obj, lv_btnmatrix_get_selected_btn(obj));
     if (lv_obj_get_user_data(obj) == (void *)100) {
         if (std::string(txt) == "far side") {
-            controller.rumble("._");
+            controller_output.rumble("._");
             selected_auto = AutoMode::FAR_SIDE;
         } else if (std::string(txt) == "close side") {
-            controller.rumble(".. _");
+            controller_output.rumble(".. _");
             selected_auto = AutoMode::CLOSE_SIDE;
         } else if (std::string(txt) == "skills") {
-            controller.rumble("_._");
+            controller_output.rumble("_._");
             selected_auto = AutoMode::SKILLS;
         }
     }
@@ -55,10 +60,29 @@ void initializeGUI() {
     lv_dropdown_set_options(autoSelector, "Off\nClose Side\nFar Side\nSkills");
     lv_obj_align(autoSelector, LV_ALIGN_CENTER, 0, 0);
     lv_obj_add_event_cb(autoSelector, autoSelectorCallback, LV_EVENT_VALUE_CHANGED, NULL);
+
+    // Create profiler tab
+    lv_obj_t *profileTab = lv_tabview_add_tab(tabview, "Profiler");
+    profileLabel = lv_label_create(profileTab);
+    lv_label_set_text(profileLabel, "no samples yet");
+    lv_obj_align(profileLabel, LV_ALIGN_TOP_LEFT, 0, 0);
 }
 
 void updateGUI() {
-    // Add any GUI update logic here if needed
+    // Refresh the profiler table twice a second, red while stages are overrunning
+    if (profileLabel == nullptr || pros::millis() - lastProfileRefresh < 500) return;
+    lastProfileRefresh = pros::millis();
+
+    static char table[1024];
+    loop_profiler.format(table, sizeof(table));
+    lv_label_set_text(profileLabel, table);
+
+    std::uint32_t overruns = loop_profiler.getOverruns();
+    lv_obj_set_style_text_color(profileLabel,
+                                overruns != lastProfileOverruns ? lv_palette_main(LV_PALETTE_RED)
+                                                                : lv_color_white(),
+                                LV_PART_MAIN);
+    lastProfileOverruns = overruns;
 }
 
-} // namespace screen
\ No newline at end of file
+} // namespace gui
\ No newline at end of file
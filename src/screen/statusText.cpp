@@ -0,0 +1,54 @@
+#include "screen/statusText.hpp"
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+#include "pros/llemu.hpp"
+#include "pros/rtos.hpp"
+
+namespace gui {
+
+StatusText::StatusText(std::uint32_t renderInterval)
+    : renderInterval(renderInterval) {}
+
+void StatusText::print(int line, const char* fmt, ...) {
+    char text[STATUS_LINE_LENGTH];
+    va_list args;
+    va_start(args, fmt);
+    vsnprintf(text, sizeof(text), fmt, args);
+    va_end(args);
+    stage(line, text);
+}
+
+void StatusText::clear(int line) { stage(line, ""); }
+
+void StatusText::stage(int line, const char* text) {
+    if (line < 0 || line >= STATUS_LINES) return;
+    requests++;
+    auto& current = staged[line];
+    if (std::strncmp(current.data(), text, current.size()) == 0) return;
+    std::strncpy(current.data(), text, current.size() - 1);
+    dirty |= 1 << line;
+}
+
+void StatusText::render() {
+    if (dirty == 0 || pros::millis() - lastRender < renderInterval) return;
+    lastRender = pros::millis();
+    for (int line = 0; line < STATUS_LINES; line++) {
+        if (!(dirty & (1 << line))) continue;
+        // text may have changed and changed back between renders
+        if (staged[line] == shown[line]) continue;
+        shown[line] = staged[line];
+        if (shown[line][0] == '\0') pros::lcd::clear_line(line);
+        else pros::lcd::set_text(line, shown[line].data());
+        redraws++;
+    }
+    dirty = 0;
+}
+
+void StatusText::invalidate() {
+    // 0xff never matches staged text, which is always NUL terminated
+    for (auto& line : shown) line.fill(static_cast<char>(0xff));
+    dirty = (1 << STATUS_LINES) - 1;
+}
+
+} // namespace gui
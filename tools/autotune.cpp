@@ -0,0 +1,73 @@
+// Host-side autotuner check. Runs the relay experiment from motion/relayTuner.hpp against a plant model
+// instead of the robot, then proposes gains the same way Chassis::autotune does, and compares the
+// settle time predicted from the identified plant with the settle time on the model itself. exits with 2
+// when the proposal does not settle the identified plant, as Chassis::autotune rejects it.
+//
+// usage: autotune [--gain units/s per output] [--delay s] [--lag s] [--deadband output] [--amplitude output]
+//                 [--hysteresis units] [--cycles n] [--rule 0-2] [--step units] [--settle-error units]
+//                 [--settle-timeout s] [--kp gain] [--ki gain] [--kd gain]
+//
+// the defaults model the drivetrain in src/globals.cpp in inches, and --kp/--ki/--kd default to the current
+// lateral_controller gains for comparison. for the angular controller use degrees, e.g. --gain 7.4
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <string>
+#include "motion/relayTuner.hpp"
+
+int main(int argc, char** argv) {
+    std::map<std::string, float> options = {
+        {"--gain", 0.65}, {"--delay", 0.04}, {"--lag", 0.12}, {"--deadband", 6}, {"--amplitude", 60},
+        {"--hysteresis", 0.1}, {"--cycles", 4}, {"--rule", 1}, {"--step", 24}, {"--settle-error", 1},
+        {"--settle-timeout", 0.1}, {"--kp", 10}, {"--ki", 0}, {"--kd", 3}};
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (!options.count(argv[i])) {
+            std::cerr << "unknown option " << argv[i] << "\n";
+            return 1;
+        }
+        options[argv[i]] = std::strtof(argv[i + 1], nullptr);
+    }
+
+    motion::PlantModel plant(options["--gain"], options["--delay"], options["--lag"], options["--deadband"]);
+    motion::RelayTuner relay(options["--amplitude"], options["--hysteresis"], options["--cycles"]);
+    float t = 0;
+    for (; t < 30 && !relay.done(); t += 0.01) plant.update(relay.update(t, -plant.getPosition()));
+    if (!relay.done()) {
+        std::cerr << "no sustained oscillation in 30 s\n";
+        return 1;
+    }
+
+    const auto rule = static_cast<motion::TuningRule>(std::clamp<int>(options["--rule"], 0, 2));
+    const motion::TuneResult result =
+        motion::proposeGains(relay, rule, options["--step"], options["--settle-error"], options["--settle-timeout"]);
+    std::printf("relay: %.2f s, Ku %.3f, Tu %.3f s, oscillation %.3f\n", t, result.ultimateGain,
+                result.ultimatePeriod, relay.getOscillation());
+    std::printf("identified plant: gain %.3f, delay %.3f s, lag %.3f s, deadband %.2f (model: gain %.3f, delay "
+                "%.3f s, lag %.3f s, deadband %.2f)\n",
+                result.plantGain, result.plantDelay, result.plantLag, result.plantDeadband, options["--gain"],
+                options["--delay"], options["--lag"], options["--deadband"]);
+    std::printf("proposed: kP %.3f, kI %.3f, kD %.3f\n", result.gains.kP, result.gains.kI, result.gains.kD);
+
+    const float settleError = options["--settle-error"], settleTimeout = options["--settle-timeout"];
+    plant.reset();
+    const float actual = motion::simulateSettle(plant, result.gains, options["--step"], settleError, settleTimeout);
+    const float current = motion::simulateSettle(plant, {options["--kp"], options["--ki"], options["--kd"]},
+                                                 options["--step"], settleError, settleTimeout);
+    auto describe = [](float time) {
+        char text[32] = "does not settle";
+        if (time >= 0) std::snprintf(text, sizeof(text), "%.2f s", time);
+        return std::string(text);
+    };
+    std::printf("settle time for a %.1f step: predicted %s, on the model %s, current gains %s\n", options["--step"],
+                describe(result.settleTime).c_str(), describe(actual).c_str(), describe(current).c_str());
+    if (result.settleTime < 0) {
+        std::printf("rejected: the proposal does not settle the identified plant. within %.2f of the target the P "
+                    "term is under the deadband, so raise kP or add kI\n",
+                    result.plantDeadband / result.gains.kP);
+        return 2;
+    }
+    return 0;
+}
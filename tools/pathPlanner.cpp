@@ -0,0 +1,139 @@
+// Host-side path planner. Reads waypoints (x, y per line, or an existing LemLib path asset) and writes
+// a LemLib path asset whose speed column is the time-optimal velocity profile for the drivetrain.
+// An output ending in .bin is written in the binary format from motion/pathView.hpp instead, with
+// velocities in inches/s and the curvature of each point, and without path.jerryio's repeated end
+// point and lookahead extension.
+//
+// usage: pathplanner <input> <output> [--track-width in] [--rpm rpm] [--wheel-diameter in]
+//                    [--max-accel in/s^2] [--max-lateral-accel in/s^2] [--ks V] [--kv V/(in/s)]
+//                    [--ka V/(in/s^2)] [--start-speed in/s] [--end-speed in/s] [--min-speed 0-127]
+//
+// defaults match the drivetrain and feedforward in src/globals.cpp. LemLib's follow() drives at the
+// speed of the closest point, so every point before the end gets at least --min-speed or the robot
+// would never start or would stall short of the end
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include "motion/pathView.hpp"
+#include "motion/velocityPlanner.hpp"
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        std::cerr << "usage: pathplanner <input> <output> [--option value]...\n";
+        return 1;
+    }
+    std::map<std::string, float> options = {
+        {"--track-width", 10}, {"--rpm", 480}, {"--wheel-diameter", 3.25}, {"--max-accel", 120},
+        {"--max-lateral-accel", 0}, {"--ks", 0.8}, {"--kv", 0.137}, {"--ka", 0.02},
+        {"--start-speed", 0}, {"--end-speed", 0}, {"--min-speed", 20}};
+    for (int i = 3; i + 1 < argc; i += 2) {
+        if (!options.count(argv[i])) {
+            std::cerr << "unknown option " << argv[i] << "\n";
+            return 1;
+        }
+        options[argv[i]] = std::strtof(argv[i + 1], nullptr);
+    }
+
+    std::ifstream input(argv[1]);
+    if (!input) {
+        std::cerr << "cannot open " << argv[1] << "\n";
+        return 1;
+    }
+    // points come before "endData"; anything after it (path.jerryio metadata) is kept as is
+    std::vector<motion::PathPoint> points;
+    std::string line, trailer;
+    while (std::getline(input, line)) {
+        if (line.rfind("endData", 0) == 0) {
+            std::stringstream rest;
+            rest << line << "\n" << input.rdbuf();
+            trailer = rest.str();
+            break;
+        }
+        float x, y;
+        if (std::sscanf(line.c_str(), " %f , %f", &x, &y) == 2) points.push_back({x, y});
+    }
+    if (points.size() < 2) {
+        std::cerr << "need at least two points\n";
+        return 1;
+    }
+
+    motion::DriveLimits limits;
+    limits.trackWidth = options["--track-width"];
+    // free speed of the wheels, which is what 127 means in a LemLib path
+    const float freeSpeed = options["--rpm"] * options["--wheel-diameter"] * M_PI / 60;
+    limits.maxWheelAcceleration = options["--max-accel"];
+    limits.maxLateralAcceleration = options["--max-lateral-accel"];
+    limits.left = {options["--ks"], options["--kv"], options["--ka"]};
+    limits.right = limits.left;
+    limits.maxWheelVelocity = freeSpeed;
+    if (limits.left.kV > 0) limits.maxWheelVelocity = std::min(freeSpeed, limits.left.maxVelocity(limits.voltage));
+
+    // path.jerryio ends a path with a repeated end point and a lookahead extension past it. plan up to the
+    // real end; the extension keeps the end speed
+    std::size_t end = points.size();
+    for (std::size_t i = 0; i + 1 < points.size(); i++) {
+        if (points[i].x == points[i + 1].x && points[i].y == points[i + 1].y) {
+            end = i + 1;
+            break;
+        }
+    }
+    std::vector<motion::PathPoint> planned(points.begin(), points.begin() + end);
+    const float minSpeed = options["--min-speed"] / 127 * freeSpeed;
+    motion::computeCurvature(planned);
+    const float time = motion::planVelocities(planned, limits, std::max(options["--start-speed"], minSpeed),
+                                              options["--end-speed"]);
+    for (std::size_t i = 0; i < points.size(); i++) {
+        if (i + 1 < planned.size()) points[i].velocity = std::max(planned[i].velocity, minSpeed);
+        else points[i].velocity = options["--end-speed"];
+        if (i < planned.size()) points[i].curvature = planned[i].curvature;
+    }
+
+    const std::string outputName = argv[2];
+    const bool binary = outputName.size() > 4 && outputName.compare(outputName.size() - 4, 4, ".bin") == 0;
+    std::ofstream output(outputName, binary ? std::ios::binary : std::ios::out);
+    if (!output) {
+        std::cerr << "cannot write " << argv[2] << "\n";
+        return 1;
+    }
+    if (binary) {
+        // the binary format ends at the real end point. the robot stops there, so the repeated end point
+        // and the extension past it would only leave the follower waiting for a segment it never reaches
+        points.resize(planned.size());
+        std::vector<motion::PackedPathPoint> packed;
+        for (const motion::PathPoint& point : points) packed.push_back(motion::packPathPoint(point));
+        motion::PathHeader header = {motion::PATH_MAGIC, motion::PATH_VERSION, sizeof(motion::PackedPathPoint),
+                                     static_cast<std::uint32_t>(packed.size()), INT16_MAX, INT16_MAX, INT16_MIN,
+                                     INT16_MIN, 0};
+        for (const motion::PackedPathPoint& point : packed) {
+            header.minX = std::min(header.minX, point.x);
+            header.minY = std::min(header.minY, point.y);
+            header.maxX = std::max(header.maxX, point.x);
+            header.maxY = std::max(header.maxY, point.y);
+        }
+        const auto* data = reinterpret_cast<const std::uint8_t*>(packed.data());
+        const std::size_t size = packed.size() * sizeof(motion::PackedPathPoint);
+        header.checksum = motion::pathChecksum(data, size);
+        output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        output.write(reinterpret_cast<const char*>(data), size);
+        std::printf("%s: %zu points, %zu bytes, %.2f s\n", argv[2], points.size(), sizeof(header) + size, time);
+        return 0;
+    }
+    char buffer[96];
+    for (const motion::PathPoint& point : points) {
+        std::snprintf(buffer, sizeof(buffer), "%.3f, %.3f, %.3f\n", point.x, point.y,
+                      point.velocity / freeSpeed * 127);
+        output << buffer;
+    }
+    output << (trailer.empty() ? "endData\n" : trailer);
+
+    std::printf("%s: %zu points, %.2f s\n", argv[2], points.size(), time);
+    return 0;
+}
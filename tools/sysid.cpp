@@ -0,0 +1,94 @@
+// Host-side drivetrain characterization fit. Reads the terminal output of Chassis::characterize, fits the
+// feedforward model of each side, the effective track width and the wheel diameter, and prints the
+// constants for src/globals.cpp.
+//
+// usage: sysid <log file, - for stdin> [--measured inches] [--min-velocity inches/s]
+//
+// --measured is the distance the robot really covered in the first (quasistatic forward) test, measured on
+// the field. without it the wheel diameter is taken as configured
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <string>
+#include "motion/sysid.hpp"
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "usage: sysid <log file, - for stdin> [--measured inches] [--min-velocity inches/s]\n";
+        return 1;
+    }
+    std::map<std::string, float> options = {{"--measured", 0}, {"--min-velocity", 1}};
+    for (int i = 2; i + 1 < argc; i += 2) {
+        if (!options.count(argv[i])) {
+            std::cerr << "unknown option " << argv[i] << "\n";
+            return 1;
+        }
+        options[argv[i]] = std::strtof(argv[i + 1], nullptr);
+    }
+
+    motion::SysIdLog log;
+    std::ifstream file;
+    const bool fromStdin = std::string(argv[1]) == "-";
+    if (!fromStdin) {
+        file.open(argv[1]);
+        if (!file) {
+            std::cerr << "cannot open " << argv[1] << "\n";
+            return 1;
+        }
+    }
+    std::istream& in = fromStdin ? std::cin : file;
+    for (std::string line; std::getline(in, line);) log.parseLine(line);
+    if (!log.hasConfig) {
+        std::cerr << "no sysid,config line in the log\n";
+        return 1;
+    }
+    for (int test = 0; test < 6; test++) {
+        const auto id = static_cast<motion::SysIdTest>(test);
+        std::printf("%s: %zu samples, %.1f in\n", motion::sysIdTestName(id), log[id].size(),
+                    motion::testDistance(log, id));
+    }
+
+    // the log's distances use the configured wheel diameter, so a measured distance rescales all of them
+    const motion::SysIdConfig& config = log.config;
+    const float encoderDistance = motion::testDistance(log, motion::SysIdTest::QUASISTATIC_FORWARD);
+    float scale = 1;
+    if (options["--measured"] > 0 && encoderDistance > 0) scale = options["--measured"] / encoderDistance;
+
+    const float minVelocity = options["--min-velocity"];
+    motion::FeedforwardFit sides[2] = {motion::fitFeedforward(log, true, minVelocity),
+                                       motion::fitFeedforward(log, false, minVelocity)};
+    for (int side = 0; side < 2; side++) {
+        motion::FeedforwardFit& fit = sides[side];
+        if (fit.samples < 3) {
+            std::cerr << "not enough moving samples to fit the " << (side == 0 ? "left" : "right") << " side\n";
+            return 1;
+        }
+        fit.model.kV /= scale;
+        fit.model.kA /= scale;
+        std::printf("%s: kS %.3f V, kV %.4f V/(in/s), kA %.4f V/(in/s^2), R^2 %.4f over %zu samples\n",
+                    side == 0 ? "left" : "right", fit.model.kS, fit.model.kV, fit.model.kA, fit.rSquared,
+                    fit.samples);
+    }
+
+    float trackWidth = motion::fitTrackWidth(log) * scale;
+    if (trackWidth > 0) {
+        std::printf("track width: %.2f in effective, %.2f in configured, scrub factor %.3f\n", trackWidth,
+                    config.trackWidth, trackWidth / config.trackWidth);
+    } else {
+        std::printf("track width: no spin tests in the log, keeping %.2f in\n", config.trackWidth);
+        trackWidth = config.trackWidth;
+    }
+    const float wheelDiameter = config.wheelDiameter * scale;
+    std::printf("wheel diameter: %.3f in (configured %.3f in)\n", wheelDiameter, config.wheelDiameter);
+
+    // ready to paste into globals.cpp
+    std::printf("\nlemlib::Drivetrain drivetrain(&left_mg, &right_mg, %.2f, %.3f, %g, %g);\n", trackWidth,
+                wheelDiameter, config.rpm, config.horizontalDrift);
+    std::printf("motion::DriveFeedforward drive_feedforward{{%.3f, %.4f, %.4f}, {%.3f, %.4f, %.4f}, %g};\n",
+                sides[0].model.kS, sides[0].model.kV, sides[0].model.kA, sides[1].model.kS, sides[1].model.kV,
+                sides[1].model.kA, config.velocityKP);
+    return 0;
+}